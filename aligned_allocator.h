@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+// Аллокатор, выравнивающий буфер по границе Alignment байт (но не меньше alignof(T)).
+// Позволяет передавать данные Vector в выровненные загрузки AVX2/AVX-512 и начинать буфер
+// с границы кэш-линии. Вместимость округляется до целого числа блоков по Alignment байт,
+// поэтому последний SIMD-блок буфера можно читать целиком
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    static constexpr size_t kAlignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n > size_t(-1) / sizeof(T) - kAlignment) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t(kAlignment)));
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        operator delete(p, std::align_val_t(kAlignment));
+    }
+
+    size_t GoodSize(size_t n) const noexcept {
+        if (n > size_t(-1) / sizeof(T) - kAlignment) {
+            return n;
+        }
+        const size_t bytes = (n * sizeof(T) + kAlignment - 1) & ~(kAlignment - 1);
+        return bytes / sizeof(T);
+    }
+
+    bool operator==(const AlignedAllocator& /*other*/) const noexcept {
+        return true;
+    }
+    bool operator!=(const AlignedAllocator& /*other*/) const noexcept {
+        return false;
+    }
+};
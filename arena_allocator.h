@@ -0,0 +1,239 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <new>
+
+// Монотонная арена: память выделяется сдвигом указателя в больших блоках, а освобождается
+// разом через Reset или деструктор. Отдельное освобождение возвращает место, только если блок
+// выделен последним, поэтому короткоживущие векторы одного запроса не обращаются к malloc.
+// Последнее выделение можно расширить на месте (TryResize), чем пользуется ArenaAllocator:
+// вектор, растущий последним, увеличивает буфер без копирования.
+// Арена не потокобезопасна и должна жить дольше всех выделений из неё. Она же является
+// std::pmr::memory_resource и годится для std::pmr::polymorphic_allocator
+class Arena : public std::pmr::memory_resource {
+public:
+    static constexpr size_t kDefaultBlockSize = size_t(64) << 10;
+    static constexpr size_t kMaxBlockSize = size_t(64) << 20;
+
+    // first_block_size - размер первого блока; следующие блоки вдвое больше предыдущих
+    explicit Arena(size_t first_block_size = kDefaultBlockSize) noexcept
+        : first_block_size_(std::max(first_block_size, sizeof(Block) + alignof(std::max_align_t)))
+        , next_block_size_(first_block_size_)
+    {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() override
+    {
+        Release();
+    }
+
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        char* p = AlignUp(top_, alignment);
+        if (!Fits(p, bytes)) {
+            AddBlock(bytes, alignment);
+            p = AlignUp(top_, alignment);
+        }
+        last_ = p;
+        top_ = p + bytes;
+        return p;
+    }
+
+    // Возвращает место, если p - последнее выделение; иначе память освободится при Reset
+    void Deallocate(void* p, size_t bytes) noexcept
+    {
+        if (p != nullptr && p == last_ && last_ + bytes == top_) {
+            top_ = last_;
+            last_ = nullptr;
+        }
+    }
+
+    // Меняет размер последнего выделения p на месте. false, если p выделен не последним
+    // или в блоке не хватает места
+    bool TryResize(void* p, size_t old_bytes, size_t new_bytes) noexcept
+    {
+        if (p == nullptr || p != last_ || last_ + old_bytes != top_ || !Fits(last_, new_bytes)) {
+            return false;
+        }
+        top_ = last_ + new_bytes;
+        return true;
+    }
+
+    // Меняет размер выделения, сохраняя min(old_bytes, new_bytes) первых байт: на месте, если
+    // это возможно, иначе выделяет новое место и копирует
+    void* Reallocate(void* p, size_t old_bytes, size_t new_bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        if (TryResize(p, old_bytes, new_bytes)) {
+            return p;
+        }
+        void* new_p = Allocate(new_bytes, alignment);
+        if (p != nullptr) {
+            std::memcpy(new_p, p, std::min(old_bytes, new_bytes));
+        }
+        return new_p;
+    }
+
+    // Освобождает все выделения разом. Последний (самый большой) блок остаётся для
+    // следующих выделений, остальные возвращаются системе
+    void Reset() noexcept
+    {
+        if (blocks_ == nullptr) {
+            return;
+        }
+        FreeBlocks(blocks_->prev);
+        blocks_->prev = nullptr;
+        top_ = blocks_->Data();
+        last_ = nullptr;
+        reserved_ = blocks_->size;
+    }
+
+    // Освобождает все выделения и возвращает все блоки системе
+    void Release() noexcept
+    {
+        FreeBlocks(blocks_);
+        blocks_ = nullptr;
+        top_ = nullptr;
+        end_ = nullptr;
+        last_ = nullptr;
+        reserved_ = 0;
+        next_block_size_ = first_block_size_;
+    }
+
+    // Байт занято в текущем блоке
+    size_t BytesUsedInBlock() const noexcept {
+        return blocks_ == nullptr ? 0 : static_cast<size_t>(top_ - blocks_->Data());
+    }
+
+    // Байт получено от системы во всех блоках
+    size_t BytesReserved() const noexcept {
+        return reserved_;
+    }
+
+private:
+    struct alignas(std::max_align_t) Block {
+        char* Data() noexcept {
+            return reinterpret_cast<char*>(this + 1);
+        }
+
+        Block* prev;
+        size_t size;
+    };
+
+    static char* AlignUp(char* p, size_t alignment) noexcept {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(p);
+        return p + ((alignment - address % alignment) % alignment);
+    }
+
+    bool Fits(const char* p, size_t bytes) const noexcept {
+        return top_ != nullptr && p <= end_ && bytes <= static_cast<size_t>(end_ - p);
+    }
+
+    void AddBlock(size_t bytes, size_t alignment)
+    {
+        if (bytes > size_t(-1) / 2 - alignment) {
+            throw std::bad_array_new_length();
+        }
+        const size_t size = std::max(next_block_size_, sizeof(Block) + bytes + alignment);
+        Block* block = static_cast<Block*>(operator new(size));
+        block->prev = blocks_;
+        block->size = size;
+        blocks_ = block;
+        top_ = block->Data();
+        end_ = reinterpret_cast<char*>(block) + size;
+        last_ = nullptr;
+        reserved_ += size;
+        next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+    }
+
+    static void FreeBlocks(Block* block) noexcept
+    {
+        while (block != nullptr) {
+            Block* prev = block->prev;
+            operator delete(block);
+            block = prev;
+        }
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        return Allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t /*alignment*/) override {
+        Deallocate(p, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    size_t first_block_size_;
+    size_t next_block_size_;
+    Block* blocks_ = nullptr;
+    // Свободное место текущего блока [top_, end_); last_ - начало последнего выделения
+    char* top_ = nullptr;
+    char* end_ = nullptr;
+    char* last_ = nullptr;
+    size_t reserved_ = 0;
+};
+
+// Аллокатор Vector поверх Arena. Метод Reallocate позволяет Vector с тривиально
+// перемещаемыми элементами расти на месте, пока его буфер выделен в арене последним.
+// Освобождение памяти почти бесплатно: место возвращается при Arena::Reset
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(Arena& arena) noexcept
+        : arena_(&arena)
+    {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_(&other.GetArena())
+    {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(ToBytes(n), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        arena_->Deallocate(p, n * sizeof(T));
+    }
+
+    // Меняет размер блока p с old_n до new_n элементов, сохраняя min(old_n, new_n) первых из них
+    T* Reallocate(T* p, size_t old_n, size_t new_n) {
+        return static_cast<T*>(arena_->Reallocate(p, old_n * sizeof(T), ToBytes(new_n), alignof(T)));
+    }
+
+    Arena& GetArena() const noexcept {
+        return *arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == &other.GetArena();
+    }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    static size_t ToBytes(size_t n) {
+        if (n > size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    Arena* arena_;
+};
@@ -0,0 +1,690 @@
+#include "vector.h"
+#include "huge_page_allocator.h"
+#include "concurrent_vector.h"
+#include "vector_search.h"
+#include "flat_map.h"
+#include "arena_allocator.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // Счётчики выделений через глобальный operator new. Контейнеры сравниваются со стандартным
+    // аллокатором, с которым их и используют; учитываются и выделения внутри элементов
+    struct AllocationStats {
+        static void Reset() {
+            bytes = 0;
+            count = 0;
+        }
+
+        static inline std::atomic<size_t> bytes{ 0 };
+        static inline std::atomic<size_t> count{ 0 };
+    };
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    AllocationStats::bytes.fetch_add(size, std::memory_order_relaxed);
+    AllocationStats::count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size != 0 ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// noinline: иначе GCC, встроив free в место вызова delete, ошибочно сообщает о несоответствии
+// new/delete (-Wmismatched-new-delete)
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t /*size*/) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+
+    struct Pod64 {
+        uint64_t words[8];
+    };
+
+    // Тип с бросающим конструктором перемещения: при реаллокации его приходится копировать
+    struct ThrowingMove {
+        ThrowingMove() = default;
+        explicit ThrowingMove(size_t value)
+            : value(std::to_string(value))  //
+        {
+        }
+        ThrowingMove(const ThrowingMove& other) = default;
+        ThrowingMove(ThrowingMove&& other)
+            : value(std::move(other.value))  //
+        {
+        }
+        ThrowingMove& operator=(const ThrowingMove& other) = default;
+        ThrowingMove& operator=(ThrowingMove&& other) = default;
+
+        std::string value;
+    };
+
+    template <typename T>
+    T MakeValue(size_t i) {
+        if constexpr (std::is_same_v<T, int>) {
+            return static_cast<int>(i);
+        }
+        else if constexpr (std::is_same_v<T, std::string>) {
+            return std::to_string(i * 1'000'000'007);
+        }
+        else if constexpr (std::is_same_v<T, Pod64>) {
+            return Pod64{ { i, i, i, i, i, i, i, i } };
+        }
+        else {
+            return T(i);
+        }
+    }
+
+    template <typename T>
+    using OurVector = Vector<T>;
+
+    template <typename T>
+    using StdVector = std::vector<T>;
+
+    // Общий интерфейс Vector и std::vector для шаблонных бенчмарков
+
+    template <typename T, typename A, typename G, typename Value>
+    void PushBack(Vector<T, A, G>& v, Value&& value) {
+        v.PushBack(std::forward<Value>(value));
+    }
+    template <typename T, typename A, typename Value>
+    void PushBack(std::vector<T, A>& v, Value&& value) {
+        v.push_back(std::forward<Value>(value));
+    }
+
+    template <typename T, typename A, typename G>
+    void EmplaceBack(Vector<T, A, G>& v, size_t i) {
+        v.EmplaceBack(MakeValue<T>(i));
+    }
+    template <typename T, typename A>
+    void EmplaceBack(std::vector<T, A>& v, size_t i) {
+        v.emplace_back(MakeValue<T>(i));
+    }
+
+    template <typename T, typename A, typename G>
+    void Reserve(Vector<T, A, G>& v, size_t n) {
+        v.Reserve(n);
+    }
+    template <typename T, typename A>
+    void Reserve(std::vector<T, A>& v, size_t n) {
+        v.reserve(n);
+    }
+
+    template <typename T, typename A, typename G>
+    void Resize(Vector<T, A, G>& v, size_t n) {
+        v.Resize(n);
+    }
+    template <typename T, typename A>
+    void Resize(std::vector<T, A>& v, size_t n) {
+        v.resize(n);
+    }
+
+    template <typename T, typename A, typename G>
+    void InsertAt(Vector<T, A, G>& v, size_t index, const T& value) {
+        v.Insert(v.cbegin() + index, value);
+    }
+    template <typename T, typename A>
+    void InsertAt(std::vector<T, A>& v, size_t index, const T& value) {
+        v.insert(v.cbegin() + index, value);
+    }
+
+    template <typename T, typename A, typename G>
+    void EraseAt(Vector<T, A, G>& v, size_t index) {
+        v.Erase(v.cbegin() + index);
+    }
+    template <typename T, typename A>
+    void EraseAt(std::vector<T, A>& v, size_t index) {
+        v.erase(v.cbegin() + index);
+    }
+
+    template <typename T, typename A, typename G, typename Predicate>
+    void EraseIf(Vector<T, A, G>& v, Predicate pred) {
+        v.EraseIf(pred);
+    }
+    template <typename T, typename A, typename Predicate>
+    void EraseIf(std::vector<T, A>& v, Predicate pred) {
+        v.erase(std::remove_if(v.begin(), v.end(), pred), v.end());
+    }
+
+    template <typename T, typename A, typename G>
+    size_t Size(const Vector<T, A, G>& v) {
+        return v.Size();
+    }
+    template <typename T, typename A>
+    size_t Size(const std::vector<T, A>& v) {
+        return v.size();
+    }
+
+    template <typename Container>
+    Container MakeContainer(size_t size) {
+        Container c;
+        Reserve(c, size);
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack(c, i);
+        }
+        return c;
+    }
+
+    // Время на элемент, число и объём выделений памяти за итерацию
+    void SetCounters(benchmark::State& state, size_t items_per_iteration) {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * items_per_iteration));
+        state.counters["time/item"] = benchmark::Counter(static_cast<double>(items_per_iteration),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+        state.counters["bytes_allocated"] = benchmark::Counter(static_cast<double>(AllocationStats::bytes),
+            benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+        state.counters["allocations"] = benchmark::Counter(static_cast<double>(AllocationStats::count),
+            benchmark::Counter::kAvgIterations);
+    }
+
+    enum Position : int64_t {
+        kFront,
+        kMiddle,
+        kBack,
+    };
+
+    size_t PositionIndex(int64_t position, size_t size) {
+        switch (position) {
+        case kFront:
+            return 0;
+        case kMiddle:
+            return size / 2;
+        default:
+            return size;
+        }
+    }
+
+}  // namespace
+
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    const T value = MakeValue<T>(size);
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        Container c;
+        for (size_t i = 0; i < size; ++i) {
+            PushBack(c, value);
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    SetCounters(state, size);
+}
+
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        Container c;
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack(c, i);
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    SetCounters(state, size);
+}
+
+// Перенос size элементов в буфер вдвое большей вместимости
+template <typename Container>
+void BM_Reserve(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = source;
+        state.ResumeTiming();
+        Reserve(c, size * 2);
+        benchmark::DoNotOptimize(c);
+    }
+    SetCounters(state, size);
+}
+
+template <typename Container>
+void BM_Resize(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        Container c;
+        Resize(c, size);
+        benchmark::DoNotOptimize(c);
+    }
+    SetCounters(state, size);
+}
+
+// Вставка и удаление одного элемента в начале, середине или конце вектора из size элементов
+template <typename Container>
+void BM_InsertErase(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    const size_t index = PositionIndex(state.range(1), size);
+    Container c = MakeContainer<Container>(size);
+    Reserve(c, size + 1);
+    const T value = MakeValue<T>(size);
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        InsertAt(c, index, value);
+        EraseAt(c, index);
+        benchmark::ClobberMemory();
+    }
+    SetCounters(state, 1);
+}
+
+template <typename Container>
+void BM_CopyAssign(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    Container target = MakeContainer<Container>(size);
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        target = source;
+        benchmark::ClobberMemory();
+    }
+    SetCounters(state, size);
+}
+
+// Присваивание в пустой вектор: память выделяется заново на каждой итерации
+template <typename Container>
+void BM_CopyAssignGrow(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container target;
+        state.ResumeTiming();
+        target = source;
+        benchmark::DoNotOptimize(target);
+        state.PauseTiming();
+        target = Container();
+        state.ResumeTiming();
+    }
+    SetCounters(state, size);
+}
+
+template <typename Container>
+void BM_MoveAssign(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Container first = MakeContainer<Container>(size);
+    Container second;
+    AllocationStats::Reset();
+    for (auto _ : state) {
+        second = std::move(first);
+        first = std::move(second);
+        benchmark::ClobberMemory();
+    }
+    SetCounters(state, 2);
+}
+
+// Удаление каждого второго элемента: цикл Erase против одного прохода EraseIf/remove_if
+template <typename Container>
+void BM_EraseEverySecondLoop(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = source;
+        state.ResumeTiming();
+        for (size_t i = 0; i < Size(c); ++i) {
+            EraseAt(c, i);
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    SetCounters(state, size / 2);
+}
+
+template <typename Container>
+void BM_EraseEverySecondIf(benchmark::State& state) {
+    using T = typename Container::value_type;
+    const size_t size = static_cast<size_t>(state.range(0));
+    const Container source = MakeContainer<Container>(size);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = source;
+        state.ResumeTiming();
+        size_t index = 0;
+        EraseIf(c, [&index](const T&) {
+            return index++ % 2 == 1;
+            });
+        benchmark::DoNotOptimize(c);
+    }
+    SetCounters(state, size / 2);
+}
+
+// Случайный доступ по псевдослучайным индексам к вектору размером state.range(0) байт
+template <typename Alloc>
+void BM_RandomAccess(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) / sizeof(uint64_t);
+    Vector<uint64_t, Alloc> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = i;
+    }
+    const size_t reads = 1 << 20;
+    uint64_t index = 1;
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < reads; ++i) {
+            index = index * 6364136223846793005ULL + 1442695040888963407ULL;
+            sum += v[(index >> 17) % size];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * reads));
+}
+
+// Добавление из state.threads() потоков в общий ConcurrentVector
+void BM_ConcurrentPushBack(benchmark::State& state) {
+    static std::unique_ptr<ConcurrentVector<uint64_t>> shared;
+    if (state.thread_index() == 0) {
+        shared = std::make_unique<ConcurrentVector<uint64_t>>();
+    }
+    uint64_t value = static_cast<uint64_t>(state.thread_index());
+    for (auto _ : state) {
+        shared->PushBack(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        shared.reset();
+    }
+}
+
+// То же для Vector под мьютексом
+void BM_MutexPushBack(benchmark::State& state) {
+    static std::unique_ptr<Vector<uint64_t>> shared;
+    static std::mutex mutex;
+    if (state.thread_index() == 0) {
+        shared = std::make_unique<Vector<uint64_t>>();
+    }
+    uint64_t value = static_cast<uint64_t>(state.thread_index());
+    for (auto _ : state) {
+        std::lock_guard guard(mutex);
+        shared->PushBack(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        shared.reset();
+    }
+}
+
+// Поиск отсутствующего значения: полный проход по state.range(0) байт, от L1 до оперативной памяти.
+// Level - набор инструкций, kScalar соответствует std::find
+template <typename T, SimdLevel Level>
+void BM_IndexOf(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) / sizeof(T);
+    Vector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<T>(i % 1000);
+    }
+    if (SetSimdLevel(Level) != Level) {
+        state.SkipWithError("SIMD level is not supported");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(IndexOf(v, T(-1)));
+    }
+    SetSimdLevel(DetectSimdLevel());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(T)));
+}
+
+template <typename T>
+void BM_StdFind(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) / sizeof(T);
+    Vector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<T>(i % 1000);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(v.begin(), v.end(), T(-1)));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(T)));
+}
+
+template <typename T, SimdLevel Level>
+void BM_MinMax(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0)) / sizeof(T);
+    Vector<T> v(size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = static_cast<T>(i % 1000);
+    }
+    if (SetSimdLevel(Level) != Level) {
+        state.SkipWithError("SIMD level is not supported");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(MinMax(v));
+    }
+    SetSimdLevel(DetectSimdLevel());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * sizeof(T)));
+}
+
+// Значение существующего ключа
+size_t Lookup(const std::map<uint64_t, size_t>& map, uint64_t key) {
+    return map.find(key)->second;
+}
+
+size_t Lookup(const FlatMap<uint64_t, size_t>& map, uint64_t key) {
+    return *map.Find(key);
+}
+
+// Поиск случайных существующих ключей в словаре из state.range(0) элементов
+template <typename Map>
+void BM_MapLookup(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    Vector<std::pair<uint64_t, size_t>> entries;
+    uint64_t seed = 1;
+    for (size_t i = 0; i < size; ++i) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        entries.EmplaceBack(seed >> 16, i);
+    }
+    const Map map(entries.begin(), entries.end());
+    const size_t lookups = 1 << 12;
+    size_t index = 0;
+    for (auto _ : state) {
+        size_t sum = 0;
+        for (size_t i = 0; i < lookups; ++i) {
+            index = (index + 7919) % size;
+            sum += Lookup(map, entries[index].first);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * lookups));
+}
+
+// Источники памяти для векторов одного запроса; EndRequest вызывается после обработки запроса
+struct HeapRequest {
+    template <typename T>
+    using Alloc = std::allocator<T>;
+
+    template <typename T>
+    Alloc<T> MakeAllocator() {
+        return {};
+    }
+
+    void EndRequest() {
+    }
+};
+
+struct ArenaRequest {
+    template <typename T>
+    using Alloc = ArenaAllocator<T>;
+
+    template <typename T>
+    Alloc<T> MakeAllocator() {
+        return Alloc<T>(arena);
+    }
+
+    void EndRequest() {
+        arena.Reset();
+    }
+
+    Arena arena;
+};
+
+struct PmrRequest {
+    template <typename T>
+    using Alloc = std::pmr::polymorphic_allocator<T>;
+
+    template <typename T>
+    Alloc<T> MakeAllocator() {
+        return Alloc<T>(&resource);
+    }
+
+    void EndRequest() {
+        resource.release();
+    }
+
+    std::pmr::monotonic_buffer_resource resource;
+};
+
+// Обработка запроса: state.range(0) векторов по 1-256 элементов создаются, заполняются
+// и уничтожаются. Идентификаторы заполняются по одному, затем из них строятся веса
+// и выбранные пары; каждый вектор растёт без Reserve
+template <typename Request>
+void BM_RequestVectors(benchmark::State& state) {
+    struct Entry {
+        uint64_t key;
+        double weight;
+    };
+    const size_t vectors = static_cast<size_t>(state.range(0));
+    Request request;
+    uint64_t seed = 1;
+    for (auto _ : state) {
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < vectors; ++i) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            const size_t size = 1 + (seed >> 33) % 256;
+            Vector<uint32_t, typename Request::template Alloc<uint32_t>> ids(request.template MakeAllocator<uint32_t>());
+            for (size_t j = 0; j < size; ++j) {
+                ids.PushBack(static_cast<uint32_t>(j * 2654435761u));
+            }
+            Vector<double, typename Request::template Alloc<double>> weights(request.template MakeAllocator<double>());
+            Vector<Entry, typename Request::template Alloc<Entry>> selected(request.template MakeAllocator<Entry>());
+            for (uint32_t id : ids) {
+                weights.PushBack(id * 0.5);
+                if (id % 4 == 0) {
+                    selected.PushBack(Entry{ id, weights.Back() });
+                }
+            }
+            checksum += ids.Size() + weights.Size() + selected.Size();
+        }
+        benchmark::DoNotOptimize(checksum);
+        request.EndRequest();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * vectors));
+}
+
+namespace {
+
+    constexpr int64_t kMaxIntSize = 100'000'000;
+    constexpr int64_t kMaxLargeSize = 1'000'000;
+    constexpr int64_t kMaxShiftSize = 100'000;
+
+    void IntSizes(benchmark::internal::Benchmark* b) {
+        b->RangeMultiplier(10)->Range(1, kMaxIntSize);
+    }
+
+    void LargeSizes(benchmark::internal::Benchmark* b) {
+        b->RangeMultiplier(10)->Range(1, kMaxLargeSize);
+    }
+
+    void ShiftSizes(benchmark::internal::Benchmark* b) {
+        for (int64_t size = 1; size <= kMaxShiftSize; size *= 10) {
+            for (int64_t position : { kFront, kMiddle, kBack }) {
+                b->Args({ size, position });
+            }
+        }
+    }
+
+    // 16 КиБ - L1, 256 КиБ - L2, 4 МиБ - L3, 256 МиБ - оперативная память
+    void SearchSizes(benchmark::internal::Benchmark* b) {
+        for (int64_t bytes : { int64_t(16) << 10, int64_t(256) << 10, int64_t(4) << 20, int64_t(256) << 20 }) {
+            b->Arg(bytes);
+        }
+    }
+
+}  // namespace
+
+#define VECTOR_BENCHMARKS(Benchmark, ...)                                  \
+    BENCHMARK_TEMPLATE(Benchmark, OurVector<int>)->Apply(__VA_ARGS__);          \
+    BENCHMARK_TEMPLATE(Benchmark, StdVector<int>)->Apply(__VA_ARGS__);          \
+    BENCHMARK_TEMPLATE(Benchmark, OurVector<std::string>)->Apply(LargeSizes);   \
+    BENCHMARK_TEMPLATE(Benchmark, StdVector<std::string>)->Apply(LargeSizes);   \
+    BENCHMARK_TEMPLATE(Benchmark, OurVector<Pod64>)->Apply(LargeSizes);         \
+    BENCHMARK_TEMPLATE(Benchmark, StdVector<Pod64>)->Apply(LargeSizes);         \
+    BENCHMARK_TEMPLATE(Benchmark, OurVector<ThrowingMove>)->Apply(LargeSizes);  \
+    BENCHMARK_TEMPLATE(Benchmark, StdVector<ThrowingMove>)->Apply(LargeSizes)
+
+VECTOR_BENCHMARKS(BM_PushBack, IntSizes);
+VECTOR_BENCHMARKS(BM_EmplaceBack, IntSizes);
+VECTOR_BENCHMARKS(BM_Reserve, IntSizes);
+VECTOR_BENCHMARKS(BM_Resize, IntSizes);
+VECTOR_BENCHMARKS(BM_CopyAssign, LargeSizes);
+VECTOR_BENCHMARKS(BM_CopyAssignGrow, LargeSizes);
+VECTOR_BENCHMARKS(BM_MoveAssign, LargeSizes);
+
+BENCHMARK_TEMPLATE(BM_InsertErase, OurVector<int>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, StdVector<int>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, OurVector<std::string>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, StdVector<std::string>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, OurVector<Pod64>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, StdVector<Pod64>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, OurVector<ThrowingMove>)->Apply(ShiftSizes);
+BENCHMARK_TEMPLATE(BM_InsertErase, StdVector<ThrowingMove>)->Apply(ShiftSizes);
+
+BENCHMARK_TEMPLATE(BM_EraseEverySecondLoop, OurVector<int>)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_EraseEverySecondIf, OurVector<int>)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_EraseEverySecondIf, StdVector<int>)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_EraseEverySecondLoop, OurVector<std::string>)->Range(1 << 8, 1 << 14);
+BENCHMARK_TEMPLATE(BM_EraseEverySecondIf, OurVector<std::string>)->Range(1 << 8, 1 << 20);
+BENCHMARK_TEMPLATE(BM_EraseEverySecondIf, StdVector<std::string>)->Range(1 << 8, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_RandomAccess, std::allocator<uint64_t>)->Arg(int64_t(256) << 20);
+BENCHMARK_TEMPLATE(BM_RandomAccess, HugePageAllocator<uint64_t>)->Arg(int64_t(256) << 20);
+
+BENCHMARK(BM_ConcurrentPushBack)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(BM_MutexPushBack)->ThreadRange(1, 64)->UseRealTime();
+
+#define SEARCH_BENCHMARKS(Benchmark, T)                                              \
+    BENCHMARK_TEMPLATE(Benchmark, T, SimdLevel::kScalar)->Apply(SearchSizes);        \
+    BENCHMARK_TEMPLATE(Benchmark, T, SimdLevel::kSse42)->Apply(SearchSizes);         \
+    BENCHMARK_TEMPLATE(Benchmark, T, SimdLevel::kAvx2)->Apply(SearchSizes);          \
+    BENCHMARK_TEMPLATE(Benchmark, T, SimdLevel::kAvx512)->Apply(SearchSizes)
+
+BENCHMARK_TEMPLATE(BM_StdFind, int32_t)->Apply(SearchSizes);
+SEARCH_BENCHMARKS(BM_IndexOf, int32_t);
+BENCHMARK_TEMPLATE(BM_StdFind, float)->Apply(SearchSizes);
+SEARCH_BENCHMARKS(BM_IndexOf, float);
+SEARCH_BENCHMARKS(BM_MinMax, int32_t);
+SEARCH_BENCHMARKS(BM_MinMax, float);
+
+BENCHMARK_TEMPLATE(BM_MapLookup, std::map<uint64_t, size_t>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapLookup, FlatMap<uint64_t, size_t>)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_RequestVectors, HeapRequest)->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_RequestVectors, PmrRequest)->Arg(100)->Arg(1000);
+BENCHMARK_TEMPLATE(BM_RequestVectors, ArenaRequest)->Arg(100)->Arg(1000);
+
+BENCHMARK_MAIN();
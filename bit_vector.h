@@ -0,0 +1,506 @@
+#pragma once
+#include <cstdint>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIT_VECTOR_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "vector.h"
+
+namespace bit_vector_detail {
+
+    inline size_t PopCount(uint64_t word) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_popcountll(word));
+#else
+        size_t count = 0;
+        for (; word != 0; word &= word - 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    // Номер младшего установленного бита, word != 0
+    inline size_t CountTrailingZeros(uint64_t word) noexcept
+    {
+#if defined(__GNUC__)
+        return static_cast<size_t>(__builtin_ctzll(word));
+#else
+        size_t count = 0;
+        for (; (word & 1) == 0; word >>= 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    enum class BitOp {
+        kAnd,
+        kOr,
+        kXor,
+    };
+
+    template <BitOp Op>
+    inline uint64_t ApplyBitOp(uint64_t a, uint64_t b) noexcept
+    {
+        if constexpr (Op == BitOp::kAnd) {
+            return a & b;
+        }
+        else if constexpr (Op == BitOp::kOr) {
+            return a | b;
+        }
+        else {
+            return a ^ b;
+        }
+    }
+
+#ifdef BIT_VECTOR_X86_KERNELS
+
+    // Процессор поддерживает AVX2. Определяется один раз; при сборке с -mavx2 проверка не нужна
+    inline bool HasAvx2() noexcept
+    {
+#ifdef __AVX2__
+        return true;
+#else
+        static const bool has_avx2 = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return has_avx2;
+#endif
+    }
+
+    // Процессор поддерживает инструкцию popcnt. Без неё __builtin_popcountll вызывает
+    // программную реализацию из libgcc
+    inline bool HasPopcnt() noexcept
+    {
+#ifdef __POPCNT__
+        return true;
+#else
+        static const bool has_popcnt = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("popcnt") != 0;
+        }();
+        return has_popcnt;
+#endif
+    }
+
+    // Четыре независимых суммы, чтобы задержка popcnt не ограничивала скорость
+    __attribute__((target("popcnt"))) inline size_t CountPopcnt(const uint64_t* words, size_t n)
+    {
+        uint64_t counts[4] = {};
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            counts[0] += __builtin_popcountll(words[i]);
+            counts[1] += __builtin_popcountll(words[i + 1]);
+            counts[2] += __builtin_popcountll(words[i + 2]);
+            counts[3] += __builtin_popcountll(words[i + 3]);
+        }
+        for (; i < n; ++i) {
+            counts[0] += __builtin_popcountll(words[i]);
+        }
+        return static_cast<size_t>(counts[0] + counts[1] + counts[2] + counts[3]);
+    }
+
+    // Ядра обрабатывают блоки по четыре слова и возвращают число обработанных слов,
+    // остаток обрабатывает вызывающий код
+    template <BitOp Op>
+    __attribute__((target("avx2"))) inline size_t CombineAvx2(uint64_t* words, const uint64_t* other, size_t n)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i* p = reinterpret_cast<__m256i*>(words + i);
+            const __m256i a = _mm256_loadu_si256(p);
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(other + i));
+            if constexpr (Op == BitOp::kAnd) {
+                _mm256_storeu_si256(p, _mm256_and_si256(a, b));
+            }
+            else if constexpr (Op == BitOp::kOr) {
+                _mm256_storeu_si256(p, _mm256_or_si256(a, b));
+            }
+            else {
+                _mm256_storeu_si256(p, _mm256_xor_si256(a, b));
+            }
+        }
+        return i;
+    }
+
+    __attribute__((target("avx2"))) inline size_t FlipAvx2(uint64_t* words, size_t n)
+    {
+        const __m256i ones = _mm256_set1_epi64x(-1);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i* p = reinterpret_cast<__m256i*>(words + i);
+            _mm256_storeu_si256(p, _mm256_xor_si256(_mm256_loadu_si256(p), ones));
+        }
+        return i;
+    }
+
+    // Пропускает блоки из четырёх нулевых слов, начиная с first. Возвращает номер слова,
+    // с которого продолжается поиск
+    __attribute__((target("avx2"))) inline size_t SkipZeroBlocksAvx2(const uint64_t* words, size_t first, size_t n)
+    {
+        size_t i = first;
+        for (; i + 4 <= n; i += 4) {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            if (!_mm256_testz_si256(block, block)) {
+                break;
+            }
+        }
+        return i;
+    }
+
+#endif
+
+} // namespace bit_vector_detail
+
+// Вектор битов, упакованных по 64 в слово RawMemory<uint64_t>: в 8 раз компактнее
+// Vector<bool>/Vector<uint8_t>. Вставка и удаление сдвигают хвост целыми словами, массовые
+// операции (and/or/xor/not, подсчёт, поиск) работают со словами, а на процессорах с AVX2 -
+// с блоками по 256 бит; подсчёт использует popcnt (поддержка инструкций проверяется во время
+// выполнения, флаги компилятора не нужны). Биты последнего слова за пределами размера всегда нулевые
+class BitVector {
+public:
+    static constexpr size_t npos = size_t(-1);
+
+    BitVector() = default;
+
+    explicit BitVector(size_t size, bool value = false)
+    {
+        Resize(size, value);
+    }
+
+    BitVector(const BitVector& other)
+        : words_(WordCount(other.size_))
+        , size_(other.size_)
+    {
+        CopyWords(other.words_.GetAddress(), WordCount(size_), words_.GetAddress());
+    }
+
+    BitVector(BitVector&& other) noexcept
+        : words_(std::move(other.words_))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    BitVector& operator=(const BitVector& rhs)
+    {
+        if (this != &rhs) {
+            if (WordCount(rhs.size_) > words_.Capacity()) {
+                BitVector copy(rhs);
+                Swap(copy);
+            }
+            else {
+                CopyWords(rhs.words_.GetAddress(), WordCount(rhs.size_), words_.GetAddress());
+                size_ = rhs.size_;
+            }
+        }
+        return *this;
+    }
+
+    BitVector& operator=(BitVector&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            words_ = std::move(rhs.words_);
+            size_ = std::exchange(rhs.size_, 0);
+        }
+        return *this;
+    }
+
+    void Swap(BitVector& other) noexcept
+    {
+        words_.Swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // Вместимость в битах
+    size_t Capacity() const noexcept {
+        return words_.Capacity() * kWordBits;
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        const size_t words = WordCount(new_capacity);
+        if (words > words_.Capacity()) {
+            RawMemory<uint64_t> new_words(words);
+            CopyWords(words_.GetAddress(), WordCount(size_), new_words.GetAddress());
+            words_.Swap(new_words);
+        }
+    }
+
+    void Resize(size_t new_size, bool value = false)
+    {
+        if (new_size > size_) {
+            Reserve(new_size);
+            const size_t old_words = WordCount(size_);
+            const size_t new_words = WordCount(new_size);
+            std::fill(words_ + old_words, words_ + new_words, value ? ~uint64_t(0) : 0);
+            if (value && size_ % kWordBits != 0) {
+                words_[size_ / kWordBits] |= ~uint64_t(0) << (size_ % kWordBits);
+            }
+        }
+        size_ = new_size;
+        ClearTail();
+    }
+
+    void Clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    void PushBack(bool value)
+    {
+        if (size_ == Capacity()) {
+            Reserve(DoublingGrowth::NextCapacity(words_.Capacity(), WordCount(size_ + 1)) * kWordBits);
+        }
+        if (size_ % kWordBits == 0) {
+            words_[size_ / kWordBits] = 0;
+        }
+        ++size_;
+        Set(size_ - 1, value);
+    }
+
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        Set(size_ - 1, false);
+        --size_;
+    }
+
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / kWordBits] >> (index % kWordBits)) & 1;
+    }
+
+    void Set(size_t index, bool value = true) noexcept
+    {
+        assert(index < size_);
+        const uint64_t mask = uint64_t(1) << (index % kWordBits);
+        uint64_t& word = words_[index / kWordBits];
+        word = value ? (word | mask) : (word & ~mask);
+    }
+
+    void Reset(size_t index) noexcept
+    {
+        Set(index, false);
+    }
+
+    void Flip(size_t index) noexcept
+    {
+        assert(index < size_);
+        words_[index / kWordBits] ^= uint64_t(1) << (index % kWordBits);
+    }
+
+    // Вставляет бит перед pos, сдвигая следующие биты на один. Слова после pos сдвигаются
+    // целиком с переносом старшего бита в следующее слово
+    void Insert(size_t pos, bool value)
+    {
+        assert(pos <= size_);
+        PushBack(false);
+        const size_t first = pos / kWordBits;
+        const size_t last = (size_ - 1) / kWordBits;
+        for (size_t i = last; i > first; --i) {
+            words_[i] = (words_[i] << 1) | (words_[i - 1] >> (kWordBits - 1));
+        }
+        const uint64_t low = LowMask(pos % kWordBits);
+        words_[first] = (words_[first] & low) | ((words_[first] & ~low) << 1);
+        Set(pos, value);
+        ClearTail();
+    }
+
+    // Удаляет бит pos, сдвигая следующие биты на один к началу
+    void Erase(size_t pos) noexcept
+    {
+        assert(pos < size_);
+        const size_t first = pos / kWordBits;
+        const size_t last = (size_ - 1) / kWordBits;
+        const uint64_t low = LowMask(pos % kWordBits);
+        words_[first] = (words_[first] & low) | ((words_[first] >> 1) & ~low);
+        for (size_t i = first; i < last; ++i) {
+            words_[i] |= words_[i + 1] << (kWordBits - 1);
+            words_[i + 1] >>= 1;
+        }
+        --size_;
+        ClearTail();
+    }
+
+    // Число установленных битов
+    size_t Count() const noexcept
+    {
+        const uint64_t* words = words_.GetAddress();
+        const size_t n = WordCount(size_);
+#ifdef BIT_VECTOR_X86_KERNELS
+        if (bit_vector_detail::HasPopcnt()) {
+            return bit_vector_detail::CountPopcnt(words, n);
+        }
+#endif
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            count += bit_vector_detail::PopCount(words[i]);
+        }
+        return count;
+    }
+
+    bool Any() const noexcept {
+        return FindFirst() != npos;
+    }
+
+    // Индекс первого установленного бита или npos
+    size_t FindFirst() const noexcept {
+        return FindFromWord(0);
+    }
+
+    // Индекс первого установленного бита после pos или npos
+    size_t FindNext(size_t pos) const noexcept
+    {
+        if (pos + 1 >= size_) {
+            return npos;
+        }
+        const size_t index = pos + 1;
+        const uint64_t word = words_[index / kWordBits] & ~LowMask(index % kWordBits);
+        if (word != 0) {
+            return index / kWordBits * kWordBits + bit_vector_detail::CountTrailingZeros(word);
+        }
+        return FindFromWord(index / kWordBits + 1);
+    }
+
+    // Вызывает f(index) для каждого установленного бита по возрастанию индекса
+    template <typename F>
+    void ForEachSetBit(F f) const
+    {
+        for (size_t i = 0, n = WordCount(size_); i < n; ++i) {
+            for (uint64_t word = words_[i]; word != 0; word &= word - 1) {
+                f(i * kWordBits + bit_vector_detail::CountTrailingZeros(word));
+            }
+        }
+    }
+
+    // Поэлементные операции с вектором того же размера
+    BitVector& operator&=(const BitVector& other) noexcept
+    {
+        Combine<bit_vector_detail::BitOp::kAnd>(other);
+        return *this;
+    }
+
+    BitVector& operator|=(const BitVector& other) noexcept
+    {
+        Combine<bit_vector_detail::BitOp::kOr>(other);
+        return *this;
+    }
+
+    BitVector& operator^=(const BitVector& other) noexcept
+    {
+        Combine<bit_vector_detail::BitOp::kXor>(other);
+        return *this;
+    }
+
+    // Инвертирует все биты
+    void Flip() noexcept
+    {
+        uint64_t* words = words_.GetAddress();
+        const size_t n = WordCount(size_);
+        size_t i = 0;
+#ifdef BIT_VECTOR_X86_KERNELS
+        if (bit_vector_detail::HasAvx2()) {
+            i = bit_vector_detail::FlipAvx2(words, n);
+        }
+#endif
+        for (; i < n; ++i) {
+            words[i] = ~words[i];
+        }
+        ClearTail();
+    }
+
+    bool operator==(const BitVector& other) const noexcept
+    {
+        return size_ == other.size_
+            && std::equal(words_.GetAddress(), words_.GetAddress() + WordCount(size_), other.words_.GetAddress());
+    }
+
+    bool operator!=(const BitVector& other) const noexcept {
+        return !(*this == other);
+    }
+
+    // Слова с битами; биты за пределами размера нулевые
+    const uint64_t* Words() const noexcept {
+        return words_.GetAddress();
+    }
+
+    size_t WordCount() const noexcept {
+        return WordCount(size_);
+    }
+
+private:
+    static constexpr size_t kWordBits = 64;
+
+    static size_t WordCount(size_t bits) noexcept {
+        return (bits + kWordBits - 1) / kWordBits;
+    }
+
+    // Маска младших bits битов, bits < 64
+    static uint64_t LowMask(size_t bits) noexcept {
+        return (uint64_t(1) << bits) - 1;
+    }
+
+    static void CopyWords(const uint64_t* src, size_t n, uint64_t* dst) noexcept
+    {
+        if (n != 0) {
+            std::memcpy(dst, src, n * sizeof(uint64_t));
+        }
+    }
+
+    // Обнуляет биты последнего слова за пределами размера
+    void ClearTail() noexcept
+    {
+        if (size_ % kWordBits != 0) {
+            words_[size_ / kWordBits] &= LowMask(size_ % kWordBits);
+        }
+    }
+
+    size_t FindFromWord(size_t first) const noexcept
+    {
+        const uint64_t* words = words_.GetAddress();
+        const size_t n = WordCount(size_);
+        size_t i = first;
+#ifdef BIT_VECTOR_X86_KERNELS
+        // Блоки из четырёх нулевых слов пропускаются одной проверкой
+        if (bit_vector_detail::HasAvx2()) {
+            i = bit_vector_detail::SkipZeroBlocksAvx2(words, first, n);
+        }
+#endif
+        for (; i < n; ++i) {
+            if (words[i] != 0) {
+                return i * kWordBits + bit_vector_detail::CountTrailingZeros(words[i]);
+            }
+        }
+        return npos;
+    }
+
+    template <bit_vector_detail::BitOp Op>
+    void Combine(const BitVector& other) noexcept
+    {
+        assert(size_ == other.size_);
+        uint64_t* words = words_.GetAddress();
+        const uint64_t* other_words = other.words_.GetAddress();
+        const size_t n = WordCount(size_);
+        size_t i = 0;
+#ifdef BIT_VECTOR_X86_KERNELS
+        if (bit_vector_detail::HasAvx2()) {
+            i = bit_vector_detail::CombineAvx2<Op>(words, other_words, n);
+        }
+#endif
+        for (; i < n; ++i) {
+            words[i] = bit_vector_detail::ApplyBitOp<Op>(words[i], other_words[i]);
+        }
+    }
+
+    RawMemory<uint64_t> words_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,227 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Вектор, в который много потоков одновременно добавляют элементы без блокировок.
+// Элементы хранятся в сегментах, размер каждого следующего вдвое больше предыдущего,
+// поэтому добавление никогда не переносит существующие элементы и ссылки на них стабильны.
+// EmplaceBack резервирует индекс одним атомарным инкрементом; недостающий сегмент выделяет
+// любой обратившийся к нему поток и публикует через CAS (проигравшие освобождают свой), так что
+// ни один поток не ждёт другого. Чтобы гонка почти не возникала, поток, занявший середину
+// сегмента, заранее выделяет следующий.
+// Чтение по индексу допустимо параллельно с добавлением, если элемент уже создан (IsConstructed).
+// Clear, деструктор и конструирование из других потоков не синхронизированы между собой.
+// Аллокатор вызывается из разных потоков и должен быть потокобезопасным
+template <typename T, typename Alloc = std::allocator<T>>
+class ConcurrentVector {
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+
+    ConcurrentVector() = default;
+
+    explicit ConcurrentVector(const Alloc& alloc) noexcept
+        : alloc_(alloc)
+    {
+    }
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector()
+    {
+        Clear();
+    }
+
+    // Потокобезопасно. Если конструктор T выбросит исключение, зарезервированный индекс
+    // останется пустым: IsConstructed для него вернёт false
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const size_t segment = SegmentIndex(index);
+        const size_t offset = index - SegmentBase(segment);
+        Slot& slot = GetOrAllocateSegment(segment)[offset];
+        T* p = slot.Get();
+        AllocTraits::construct(alloc_, p, std::forward<Args>(args)...);
+        slot.constructed.store(true, std::memory_order_release);
+        if (offset == SegmentSize(segment) / 2) {
+            PrepareSegment(segment + 1);
+        }
+        return *p;
+    }
+
+    template <typename Type>
+    T& PushBack(Type&& value)
+    {
+        return EmplaceBack(std::forward<Type>(value));
+    }
+
+    // Число зарезервированных индексов, включая элементы, которые ещё создаются
+    size_t Size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Элемент с индексом index создан и виден текущему потоку
+    bool IsConstructed(size_t index) const noexcept
+    {
+        const size_t segment = SegmentIndex(index);
+        if (segment >= kMaxSegments) {
+            return false;
+        }
+        const Slot* slots = segments_[segment].load(std::memory_order_acquire);
+        return slots != nullptr
+            && slots[index - SegmentBase(segment)].constructed.load(std::memory_order_acquire);
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<ConcurrentVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(IsConstructed(index));
+        const size_t segment = SegmentIndex(index);
+        return *segments_[segment].load(std::memory_order_acquire)[index - SegmentBase(segment)].Get();
+    }
+
+    // Вызывает f для каждого созданного элемента в порядке индексов
+    template <typename F>
+    void ForEach(F f)
+    {
+        const size_t size = Size();
+        for (size_t index = 0; index < size; ++index) {
+            if (IsConstructed(index)) {
+                f((*this)[index]);
+            }
+        }
+    }
+
+    // Удаляет все элементы и освобождает сегменты. Не должен выполняться параллельно с
+    // другими операциями
+    void Clear() noexcept
+    {
+        const size_t size = size_.load(std::memory_order_acquire);
+        for (size_t segment = 0; segment < kMaxSegments; ++segment) {
+            Slot* slots = segments_[segment].load(std::memory_order_acquire);
+            if (slots == nullptr) {
+                continue;
+            }
+            const size_t base = SegmentBase(segment);
+            const size_t count = std::min(SegmentSize(segment), size > base ? size - base : 0);
+            for (size_t i = 0; i < count; ++i) {
+                if (slots[i].constructed.load(std::memory_order_relaxed)) {
+                    AllocTraits::destroy(alloc_, slots[i].Get());
+                }
+            }
+            DeallocateSegment(slots, segment);
+            segments_[segment].store(nullptr, std::memory_order_relaxed);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+    Alloc GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+private:
+    struct Slot {
+        T* Get() noexcept {
+            return reinterpret_cast<T*>(storage);
+        }
+
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::atomic<bool> constructed{ false };
+    };
+
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using SlotAlloc = typename AllocTraits::template rebind_alloc<Slot>;
+    using SlotAllocTraits = std::allocator_traits<SlotAlloc>;
+
+    // Первый сегмент вмещает 2^kFirstSegmentShift элементов, сегмент k - 2^(kFirstSegmentShift + k)
+    static constexpr size_t kFirstSegmentShift = 5;
+    static constexpr size_t kFirstSegmentSize = size_t(1) << kFirstSegmentShift;
+    static constexpr size_t kMaxSegments = sizeof(size_t) * 8 - kFirstSegmentShift;
+
+    static size_t Log2(size_t value) noexcept
+    {
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value);
+#else
+        size_t result = 0;
+        while (value >>= 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    static size_t SegmentIndex(size_t index) noexcept {
+        return Log2(index + kFirstSegmentSize) - kFirstSegmentShift;
+    }
+
+    static size_t SegmentBase(size_t segment) noexcept {
+        return SegmentSize(segment) - kFirstSegmentSize;
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return size_t(1) << (segment + kFirstSegmentShift);
+    }
+
+    Slot* GetOrAllocateSegment(size_t segment)
+    {
+        Slot* slots = segments_[segment].load(std::memory_order_acquire);
+        if (slots != nullptr) {
+            return slots;
+        }
+        Slot* fresh = AllocateSegment(segment);
+        if (segments_[segment].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel,
+            std::memory_order_acquire))
+        {
+            return fresh;
+        }
+        // Сегмент уже опубликовал другой поток
+        DeallocateSegment(fresh, segment);
+        return slots;
+    }
+
+    // Заранее выделяет сегмент, пока к нему не обратились. Ошибка выделения не важна:
+    // сегмент выделит первый обратившийся к нему поток
+    void PrepareSegment(size_t segment) noexcept
+    {
+        if (segment >= kMaxSegments || segments_[segment].load(std::memory_order_relaxed) != nullptr) {
+            return;
+        }
+        try {
+            GetOrAllocateSegment(segment);
+        }
+        catch (...) {
+        }
+    }
+
+    Slot* AllocateSegment(size_t segment)
+    {
+        SlotAlloc slot_alloc(alloc_);
+        const size_t size = SegmentSize(segment);
+        Slot* slots = SlotAllocTraits::allocate(slot_alloc, size);
+        for (size_t i = 0; i < size; ++i) {
+            new (slots + i) Slot;
+        }
+        return slots;
+    }
+
+    void DeallocateSegment(Slot* slots, size_t segment) noexcept
+    {
+        static_assert(std::is_trivially_destructible_v<Slot>);
+        SlotAlloc slot_alloc(alloc_);
+        SlotAllocTraits::deallocate(slot_alloc, slots, SegmentSize(segment));
+    }
+
+    Alloc alloc_;
+    std::atomic<size_t> size_{ 0 };
+    std::atomic<Slot*> segments_[kMaxSegments] = {};
+};
@@ -0,0 +1,542 @@
+#pragma once
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.h"
+
+namespace flat_map_detail {
+
+    template <typename Compare, typename = void>
+    constexpr bool kIsTransparent = false;
+
+    template <typename Compare>
+    constexpr bool kIsTransparent<Compare, std::void_t<typename Compare::is_transparent>> = true;
+
+    // Тип, к которому приводится искомый ключ: с прозрачным компаратором ключ сравнивается
+    // как есть, иначе один раз преобразуется в Key, как в std::map
+    template <typename Key, typename Compare, typename K>
+    using LookupKey = std::conditional_t<kIsTransparent<Compare>, K, Key>;
+
+    // Индекс первого ключа, не меньшего key. Двоичный поиск без ветвлений: на каждом шаге
+    // диапазон уменьшается вдвое выбором (cmov) вместо условного перехода, поэтому
+    // промахи предсказания не зависят от искомого ключа
+    template <typename Key, typename K, typename Compare>
+    size_t LowerBound(const Key* keys, size_t size, const K& key, const Compare& comp)
+    {
+        if (size == 0) {
+            return 0;
+        }
+        const Key* base = keys;
+        while (size > 1) {
+            const size_t half = size / 2;
+            base = comp(base[half], key) ? base + half : base;
+            size -= half;
+        }
+        return static_cast<size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+    }
+
+    // Сортирует batch по ключу и удаляет повторы, оставляя первое вхождение
+    template <typename Entry, typename GetKey, typename Compare>
+    void SortUnique(Vector<Entry>& batch, GetKey get_key, const Compare& comp)
+    {
+        std::stable_sort(batch.begin(), batch.end(), [&](const Entry& lhs, const Entry& rhs) {
+            return comp(get_key(lhs), get_key(rhs));
+            });
+        auto last = std::unique(batch.begin(), batch.end(), [&](const Entry& lhs, const Entry& rhs) {
+            return !comp(get_key(lhs), get_key(rhs));
+            });
+        batch.Erase(last, batch.end());
+    }
+
+} // namespace flat_map_detail
+
+// Упорядоченное множество в отсортированном Vector: поиск - двоичный без ветвлений по
+// непрерывному массиву, без обхода узлов дерева, как в std::set. Вставка и удаление
+// сдвигают хвост, поэтому контейнер рассчитан на частые чтения и редкие изменения;
+// много ключей сразу вставляет InsertBulk. С прозрачным компаратором (по умолчанию
+// std::less<>) ключ можно искать значением другого типа, например std::string по
+// std::string_view, без создания временного Key
+template <typename Key, typename Compare = std::less<>>
+class FlatSet {
+    template <typename K>
+    using LookupKey = flat_map_detail::LookupKey<Key, Compare, K>;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using iterator = typename Vector<Key>::const_iterator;
+    using const_iterator = iterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp)
+    {
+    }
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        InsertBulk(first, last);
+    }
+
+    // Вставляет key, если его нет. Возвращает позицию ключа и признак вставки
+    template <typename K>
+    std::pair<iterator, bool> Insert(K&& key)
+    {
+        const LookupKey<std::decay_t<K>>& lookup = key;
+        const size_t index = LowerBoundIndex(lookup);
+        if (index != keys_.Size() && !comp_(lookup, keys_[index])) {
+            return { keys_.begin() + index, false };
+        }
+        return { keys_.Emplace(keys_.begin() + index, std::forward<K>(key)), true };
+    }
+
+    // Вставляет ключи диапазона за один проход: новые ключи сортируются и сливаются
+    // с существующими в новый буфер. Повторы не вставляются, исключение оставляет
+    // множество прежним
+    template <typename InputIt>
+    void InsertBulk(InputIt first, InputIt last)
+    {
+        Vector<Key> batch;
+        for (; first != last; ++first) {
+            batch.EmplaceBack(*first);
+        }
+        if (batch.Size() == 0) {
+            return;
+        }
+        auto get_key = [](const Key& key) -> const Key& {
+            return key;
+        };
+        flat_map_detail::SortUnique(batch, get_key, comp_);
+
+        Vector<Key> merged;
+        merged.Reserve(keys_.Size() + batch.Size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.Size() || j < batch.Size()) {
+            if (j == batch.Size() || (i < keys_.Size() && !comp_(batch[j], keys_[i]))) {
+                if (j < batch.Size() && !comp_(keys_[i], batch[j])) {
+                    ++j;
+                }
+                merged.EmplaceBack(std::move_if_noexcept(keys_[i++]));
+            }
+            else {
+                merged.EmplaceBack(std::move(batch[j++]));
+            }
+        }
+        keys_.Swap(merged);
+    }
+
+    // Удаляет key. Возвращает число удалённых ключей (0 или 1)
+    template <typename K>
+    size_t Erase(const K& key)
+    {
+        const LookupKey<K>& lookup = key;
+        const size_t index = LowerBoundIndex(lookup);
+        if (index == keys_.Size() || comp_(lookup, keys_[index])) {
+            return 0;
+        }
+        keys_.Erase(keys_.begin() + index);
+        return 1;
+    }
+
+    iterator Erase(const_iterator pos)
+    {
+        return keys_.Erase(pos);
+    }
+
+    template <typename K>
+    iterator Find(const K& key) const
+    {
+        const LookupKey<K>& lookup = key;
+        const size_t index = LowerBoundIndex(lookup);
+        if (index == keys_.Size() || comp_(lookup, keys_[index])) {
+            return end();
+        }
+        return begin() + index;
+    }
+
+    template <typename K>
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+
+    template <typename K>
+    size_t Count(const K& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    template <typename K>
+    iterator LowerBound(const K& key) const
+    {
+        const LookupKey<K>& lookup = key;
+        return begin() + LowerBoundIndex(lookup);
+    }
+
+    void Reserve(size_t capacity)
+    {
+        keys_.Reserve(capacity);
+    }
+
+    void Clear() noexcept
+    {
+        keys_.Clear();
+    }
+
+    void Swap(FlatSet& other) noexcept
+    {
+        keys_.Swap(other.keys_);
+        std::swap(comp_, other.comp_);
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    // Ключи по возрастанию
+    const Vector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    iterator begin() const noexcept {
+        return keys_.begin();
+    }
+    iterator end() const noexcept {
+        return keys_.end();
+    }
+
+private:
+    template <typename K>
+    size_t LowerBoundIndex(const K& key) const {
+        return flat_map_detail::LowerBound(keys_.begin(), keys_.Size(), key, comp_);
+    }
+
+    Vector<Key> keys_;
+    Compare comp_;
+};
+
+// Упорядоченный словарь на двух отсортированных Vector: ключи и значения хранятся
+// раздельно, поэтому поиск читает только плотный массив ключей и не тратит кеш на
+// значения. Поиск, вставка и прозрачный компаратор - как у FlatSet.
+// Find возвращает указатель на значение или nullptr. Итератор выдаёт пары ссылок
+// std::pair<const Key&, Value&> и подходит для range-for и структурных привязок
+template <typename Key, typename Value, typename Compare = std::less<>>
+class FlatMap {
+    template <typename K>
+    using LookupKey = flat_map_detail::LookupKey<Key, Compare, K>;
+
+    template <bool IsConst>
+    class Iterator {
+        using MapPointer = std::conditional_t<IsConst, const FlatMap*, FlatMap*>;
+        using ValueRef = std::conditional_t<IsConst, const Value&, Value&>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const Key&, ValueRef>;
+        using difference_type = std::ptrdiff_t;
+        using reference = value_type;
+        using pointer = void;
+
+        Iterator() = default;
+
+        Iterator(MapPointer map, size_t index) noexcept
+            : map_(map)
+            , index_(index)
+        {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : map_(other.map_)
+            , index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return reference(map_->keys_[index_], map_->values_[index_]);
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class Iterator<!IsConst>;
+
+        MapPointer map_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using key_compare = Compare;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp)
+    {
+    }
+
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        InsertBulk(first, last);
+    }
+
+    // Вставляет значение из args, если ключа нет. Возвращает указатель на значение
+    // ключа и признак вставки
+    template <typename K, typename... Args>
+    std::pair<Value*, bool> Emplace(K&& key, Args&&... args)
+    {
+        const LookupKey<std::decay_t<K>>& lookup = key;
+        const size_t index = LowerBoundIndex(lookup);
+        if (index != keys_.Size() && !comp_(lookup, keys_[index])) {
+            return { &values_[index], false };
+        }
+        return { InsertAt(index, std::forward<K>(key), std::forward<Args>(args)...), true };
+    }
+
+    template <typename K, typename V>
+    std::pair<Value*, bool> Insert(K&& key, V&& value)
+    {
+        return Emplace(std::forward<K>(key), std::forward<V>(value));
+    }
+
+    // Вставляет значение или присваивает его существующему ключу
+    template <typename K, typename V>
+    std::pair<Value*, bool> InsertOrAssign(K&& key, V&& value)
+    {
+        const LookupKey<std::decay_t<K>>& lookup = key;
+        const size_t index = LowerBoundIndex(lookup);
+        if (index != keys_.Size() && !comp_(lookup, keys_[index])) {
+            values_[index] = std::forward<V>(value);
+            return { &values_[index], false };
+        }
+        return { InsertAt(index, std::forward<K>(key), std::forward<V>(value)), true };
+    }
+
+    // Значение ключа; отсутствующий ключ вставляется со значением по умолчанию
+    template <typename K>
+    Value& operator[](K&& key)
+    {
+        return *Emplace(std::forward<K>(key)).first;
+    }
+
+    // Вставляет пары (ключ, значение) диапазона за один проход: новые пары сортируются
+    // по ключу и сливаются с существующими в новые буферы. Существующие ключи и повторы
+    // внутри диапазона не перезаписываются (остаётся первое значение), исключение
+    // оставляет словарь прежним
+    template <typename InputIt>
+    void InsertBulk(InputIt first, InputIt last)
+    {
+        using Entry = std::pair<Key, Value>;
+        Vector<Entry> batch;
+        for (; first != last; ++first) {
+            batch.EmplaceBack(*first);
+        }
+        if (batch.Size() == 0) {
+            return;
+        }
+        auto get_key = [](const Entry& entry) -> const Key& {
+            return entry.first;
+        };
+        flat_map_detail::SortUnique(batch, get_key, comp_);
+
+        // Ключ и значение переносятся вместе: если бы ключ переместился, а копирование
+        // значения выбросило исключение, в словаре остался бы перемещённый ключ
+        constexpr bool kMoveExisting = (std::is_nothrow_move_constructible_v<Key>
+                && std::is_nothrow_move_constructible_v<Value>)
+            || !std::is_copy_constructible_v<Key> || !std::is_copy_constructible_v<Value>;
+        Vector<Key> merged_keys;
+        Vector<Value> merged_values;
+        merged_keys.Reserve(keys_.Size() + batch.Size());
+        merged_values.Reserve(keys_.Size() + batch.Size());
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.Size() || j < batch.Size()) {
+            if (j == batch.Size() || (i < keys_.Size() && !comp_(batch[j].first, keys_[i]))) {
+                if (j < batch.Size() && !comp_(keys_[i], batch[j].first)) {
+                    ++j;
+                }
+                if constexpr (kMoveExisting) {
+                    merged_keys.EmplaceBack(std::move(keys_[i]));
+                    merged_values.EmplaceBack(std::move(values_[i]));
+                }
+                else {
+                    merged_keys.EmplaceBack(keys_[i]);
+                    merged_values.EmplaceBack(values_[i]);
+                }
+                ++i;
+            }
+            else {
+                merged_keys.EmplaceBack(std::move(batch[j].first));
+                merged_values.EmplaceBack(std::move(batch[j].second));
+                ++j;
+            }
+        }
+        keys_.Swap(merged_keys);
+        values_.Swap(merged_values);
+    }
+
+    // Удаляет key. Возвращает число удалённых ключей (0 или 1)
+    template <typename K>
+    size_t Erase(const K& key)
+    {
+        const size_t index = IndexOf(key);
+        if (index == keys_.Size()) {
+            return 0;
+        }
+        keys_.Erase(keys_.begin() + index);
+        values_.Erase(values_.begin() + index);
+        return 1;
+    }
+
+    template <typename K>
+    Value* Find(const K& key)
+    {
+        const size_t index = IndexOf(key);
+        return index == keys_.Size() ? nullptr : &values_[index];
+    }
+
+    template <typename K>
+    const Value* Find(const K& key) const
+    {
+        return const_cast<FlatMap&>(*this).Find(key);
+    }
+
+    // Значение ключа; если ключа нет, выбрасывает std::out_of_range
+    template <typename K>
+    Value& At(const K& key)
+    {
+        Value* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("FlatMap::At: key not found");
+        }
+        return *value;
+    }
+
+    template <typename K>
+    const Value& At(const K& key) const
+    {
+        return const_cast<FlatMap&>(*this).At(key);
+    }
+
+    template <typename K>
+    bool Contains(const K& key) const {
+        return IndexOf(key) != keys_.Size();
+    }
+
+    template <typename K>
+    size_t Count(const K& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    void Reserve(size_t capacity)
+    {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void Clear() noexcept
+    {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    void Swap(FlatMap& other) noexcept
+    {
+        keys_.Swap(other.keys_);
+        values_.Swap(other.values_);
+        std::swap(comp_, other.comp_);
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    // Ключи по возрастанию
+    const Vector<Key>& Keys() const noexcept {
+        return keys_;
+    }
+
+    // Значения в порядке ключей
+    const Vector<Value>& Values() const noexcept {
+        return values_;
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, keys_.Size());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, keys_.Size());
+    }
+
+private:
+    template <typename K>
+    size_t LowerBoundIndex(const K& key) const {
+        return flat_map_detail::LowerBound(keys_.begin(), keys_.Size(), key, comp_);
+    }
+
+    // Индекс key или Size(), если ключа нет
+    template <typename K>
+    size_t IndexOf(const K& key) const
+    {
+        const LookupKey<K>& lookup = key;
+        const size_t index = LowerBoundIndex(lookup);
+        return index != keys_.Size() && !comp_(lookup, keys_[index]) ? index : keys_.Size();
+    }
+
+    // Вставляет ключ и значение в позицию index; если значение не создалось, ключ удаляется
+    template <typename K, typename... Args>
+    Value* InsertAt(size_t index, K&& key, Args&&... args)
+    {
+        keys_.Emplace(keys_.begin() + index, std::forward<K>(key));
+        try {
+            return &*values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            keys_.Erase(keys_.begin() + index);
+            throw;
+        }
+    }
+
+    Vector<Key> keys_;
+    Vector<Value> values_;
+    Compare comp_;
+};
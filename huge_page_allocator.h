@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+// Как выделять блоки размером от порога: прозрачные huge pages (mmap + MADV_HUGEPAGE) либо
+// явные страницы из пула hugetlbfs (MAP_HUGETLB). Если пул пуст, используются прозрачные
+enum class HugePageMode {
+    kTransparent,
+    kExplicit,
+};
+
+// Аллокатор для векторов размером в гигабайты. Блоки от threshold байт выделяются через mmap,
+// выровнены на 2 МиБ и помечены для huge pages, что уменьшает число промахов TLB.
+// Блоки меньше порога выделяются обычным operator new
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+
+    static constexpr size_t kHugePageSize = size_t(2) << 20;
+    static constexpr size_t kDefaultThreshold = size_t(32) << 20;
+
+    static_assert(alignof(T) <= kHugePageSize);
+
+    explicit HugePageAllocator(size_t threshold = kDefaultThreshold, HugePageMode mode = HugePageMode::kTransparent) noexcept
+        : threshold_(threshold)
+        , mode_(mode)
+    {
+    }
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) noexcept
+        : threshold_(other.GetThreshold())
+        , mode_(other.GetMode())
+    {
+    }
+
+    T* allocate(size_t n) {
+        if (n > size_t(-1) / sizeof(T) - kHugePageSize) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (!IsHuge(bytes)) {
+            return static_cast<T*>(operator new(bytes, std::align_val_t(alignof(T))));
+        }
+        return static_cast<T*>(MapHuge(RoundUp(bytes)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsHuge(bytes)) {
+            operator delete(p, std::align_val_t(alignof(T)));
+            return;
+        }
+#ifdef __linux__
+        munmap(p, RoundUp(bytes));
+#endif
+    }
+
+    // Отображение занимает целое число huge pages, поэтому вместимость округляется до него
+    size_t GoodSize(size_t n) const noexcept {
+        if (n > size_t(-1) / sizeof(T) - kHugePageSize || !IsHuge(n * sizeof(T))) {
+            return n;
+        }
+        return RoundUp(n * sizeof(T)) / sizeof(T);
+    }
+
+    size_t GetThreshold() const noexcept {
+        return threshold_;
+    }
+
+    HugePageMode GetMode() const noexcept {
+        return mode_;
+    }
+
+    // Блоки, выделенные аллокатором с другим порогом, освобождаются иначе
+    bool operator==(const HugePageAllocator& other) const noexcept {
+        return threshold_ == other.threshold_;
+    }
+    bool operator!=(const HugePageAllocator& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    bool IsHuge(size_t bytes) const noexcept {
+#ifdef __linux__
+        return bytes != 0 && bytes >= threshold_;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    static size_t RoundUp(size_t bytes) noexcept {
+        return (bytes + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    }
+
+    void* MapHuge(size_t bytes) const {
+#ifdef __linux__
+        if (mode_ == HugePageMode::kExplicit) {
+            void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (p != MAP_FAILED) {
+                return p;
+            }
+        }
+        // mmap выравнивает только по границе страницы, поэтому берём запас в одну huge page
+        // и возвращаем системе невыровненные края
+        const size_t mapped_bytes = bytes + kHugePageSize;
+        void* mapped = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapped == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        char* begin = static_cast<char*>(mapped);
+        char* aligned = reinterpret_cast<char*>(RoundUp(reinterpret_cast<size_t>(begin)));
+        if (aligned != begin) {
+            munmap(begin, aligned - begin);
+        }
+        char* tail = aligned + bytes;
+        char* end = begin + mapped_bytes;
+        if (tail != end) {
+            munmap(tail, end - tail);
+        }
+#ifdef MADV_HUGEPAGE
+        // Ошибка не критична: без THP память останется на обычных страницах
+        madvise(aligned, bytes, MADV_HUGEPAGE);
+#endif
+        return aligned;
+#else
+        (void)bytes;
+        throw std::bad_alloc();
+#endif
+    }
+
+    size_t threshold_;
+    HugePageMode mode_;
+};
@@ -1,8 +1,36 @@
 #include "vector.h"
+#include "realloc_allocator.h"
+#include "small_vector.h"
+#include "huge_page_allocator.h"
+#include "aligned_allocator.h"
+#include "mapped_vector.h"
+#include "vector_io.h"
+#include "concurrent_vector.h"
+#include "segmented_vector.h"
+#include "numa_allocator.h"
+#include "soa_vector.h"
+#include "bit_vector.h"
+#include "vector_search.h"
+#include "flat_map.h"
+#include "arena_allocator.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
+#include <limits>
+#include <map>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <memory_resource>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -116,8 +144,121 @@ namespace {
         static inline int num_move_assigned = 0;
     };
 
+    // Аллокатор с состоянием: считает выделения и различается по id
+    template <typename T, bool Propagate>
+    struct CountingAllocator {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+        using propagate_on_container_swap = std::bool_constant<Propagate>;
+
+        explicit CountingAllocator(int id = 0) noexcept
+            : id(id)  //
+        {
+        }
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U, Propagate>& other) noexcept
+            : id(other.id)  //
+        {
+        }
+
+        T* allocate(size_t n) {
+            ++num_allocations;
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t /*n*/) noexcept {
+            ++num_deallocations;
+            operator delete(p);
+        }
+
+        bool operator==(const CountingAllocator& other) const noexcept {
+            return id == other.id;
+        }
+        bool operator!=(const CountingAllocator& other) const noexcept {
+            return id != other.id;
+        }
+
+        int id = 0;
+
+        static inline int num_allocations = 0;
+        static inline int num_deallocations = 0;
+    };
+
+    // Потокобезопасно считает выделения; счётчик общий для всех типов элементов.
+    // Если задан stall_next, следующее выделение ждёт resume
+    struct AtomicAllocationCounter {
+        static inline std::atomic<int> num_allocations{ 0 };
+        static inline std::atomic<bool> stall_next{ false };
+        static inline std::atomic<bool> stalled{ false };
+        static inline std::atomic<bool> resume{ false };
+    };
+
+    template <typename T>
+    struct AtomicCountingAllocator : AtomicAllocationCounter {
+        using value_type = T;
+
+        AtomicCountingAllocator() = default;
+
+        template <typename U>
+        AtomicCountingAllocator(const AtomicCountingAllocator<U>& /*other*/) noexcept {
+        }
+
+        T* allocate(size_t n) {
+            num_allocations.fetch_add(1, std::memory_order_relaxed);
+            if (stall_next.exchange(false)) {
+                stalled = true;
+                while (!resume) {
+                    std::this_thread::yield();
+                }
+            }
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const AtomicCountingAllocator<U>& /*other*/) const noexcept {
+            return true;
+        }
+        template <typename U>
+        bool operator!=(const AtomicCountingAllocator<U>& /*other*/) const noexcept {
+            return false;
+        }
+    };
+
+    // Тип с нетривиальным перемещением, который помечен как тривиально перемещаемый
+    struct RelocatableObj {
+        explicit RelocatableObj(int id)
+            : id(std::make_unique<int>(id))  //
+        {
+        }
+        RelocatableObj(RelocatableObj&& other) noexcept
+            : id(std::move(other.id))  //
+        {
+            ++num_moved;
+        }
+        RelocatableObj& operator=(RelocatableObj&& other) noexcept {
+            id = std::move(other.id);
+            ++num_move_assigned;
+            return *this;
+        }
+
+        std::unique_ptr<int> id;
+
+        static inline int num_moved = 0;
+        static inline int num_move_assigned = 0;
+    };
+
 }  // namespace
 
+template <>
+struct IsTriviallyRelocatable<RelocatableObj> : std::true_type {
+};
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -563,6 +704,601 @@ void Test6() {
     }
 }
 
+void Test7() {
+    using namespace std::literals;
+    const size_t SIZE = 10;
+    {
+        char buffer[1024];
+        std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+        Vector<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>> v(&resource);
+        v.EmplaceBack("short");
+        v.PushBack(std::pmr::string("a string that does not fit into SSO buffer"));
+        v.Emplace(v.cbegin(), "front");
+        assert(v.Size() == 3);
+        assert(v[0] == "front"sv);
+        // Элементы получают ресурс вектора через uses-allocator construction
+        assert(v[1].get_allocator().resource() == &resource);
+        assert(v[2].get_allocator().resource() == &resource);
+        assert(v.GetAllocator().resource() == &resource);
+    }
+    {
+        using Alloc = CountingAllocator<int, true>;
+        Alloc::num_allocations = 0;
+        Alloc::num_deallocations = 0;
+        {
+            Vector<int, Alloc> a(SIZE, Alloc{ 1 });
+            Vector<int, Alloc> b(SIZE / 2, Alloc{ 2 });
+            b = a;
+            assert(b.GetAllocator().id == 1);
+            assert(b.Size() == SIZE);
+
+            Vector<int, Alloc> c(Alloc{ 3 });
+            c = std::move(a);
+            assert(c.GetAllocator().id == 1);
+            assert(c.Size() == SIZE);
+            assert(a.Size() == 0);
+
+            b.Swap(c);
+            assert(b.GetAllocator().id == 1);
+        }
+        assert(Alloc::num_allocations == Alloc::num_deallocations);
+    }
+    {
+        using Alloc = CountingAllocator<int, false>;
+        Alloc::num_allocations = 0;
+        Alloc::num_deallocations = 0;
+        {
+            Vector<int, Alloc> a(SIZE, Alloc{ 1 });
+            a[0] = 42;
+            Vector<int, Alloc> b(Alloc{ 2 });
+            b = a;
+            assert(b.GetAllocator().id == 2);
+            b = std::move(a);
+            assert(b.GetAllocator().id == 2);
+            assert(b.Size() == SIZE);
+            assert(b[0] == 42);
+
+            Vector<int, Alloc> c(std::move(b), Alloc{ 3 });
+            assert(c.GetAllocator().id == 3);
+            assert(c[0] == 42);
+        }
+        assert(Alloc::num_allocations == Alloc::num_deallocations);
+    }
+}
+
+void Test8() {
+    const int SIZE = 100;
+    {
+        RelocatableObj::num_moved = 0;
+        RelocatableObj::num_move_assigned = 0;
+        Vector<RelocatableObj> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Reserve(SIZE * 4);
+        v.Emplace(v.cbegin() + 10, -1);
+        v.Erase(v.cbegin() + 20);
+        v.Insert(v.cbegin() + 5, RelocatableObj{ -2 });
+        assert(v.Size() == SIZE + 1);
+        assert(*v[5].id == -2);
+        assert(*v[11].id == -1);
+        assert(*v[20].id == 18);
+        assert(*v[21].id == 20);
+        // Единственное перемещение - аргумент Insert во временное значение
+        assert(RelocatableObj::num_moved == 1);
+        assert(RelocatableObj::num_move_assigned == 0);
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(std::make_unique<int>(i));
+        }
+        v.Emplace(v.cbegin(), std::make_unique<int>(-1));
+        v.Erase(v.cbegin() + 1);
+        assert(v.Size() == static_cast<size_t>(SIZE));
+        assert(*v[0] == -1);
+        assert(*v[1] == 1);
+        assert(*v[SIZE - 1] == SIZE - 1);
+    }
+}
+
+void Test9() {
+    const int SIZE = 100'000;
+    {
+        // Маленький порог, чтобы рост проходил через malloc, переход на mmap и mremap
+        Vector<int, ReallocAllocator<int, 4096>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        v.EmplaceBack(v[0]);
+        v.Emplace(v.cbegin() + 1, v[SIZE - 1]);
+        assert(v.Size() == SIZE + 2);
+        assert(v[0] == 0);
+        assert(v[1] == SIZE - 1);
+        assert(v[2] == 1);
+        assert(v[SIZE + 1] == 0);
+        v.Reserve(SIZE * 4);
+        assert(v.Capacity() >= SIZE * 4);
+        assert(v[SIZE] == SIZE - 1);
+
+        Vector<int, ReallocAllocator<int, 4096>> copy(v);
+        assert(copy.Size() == v.Size());
+        assert(std::equal(copy.begin(), copy.end(), v.begin()));
+    }
+    {
+        Vector<std::unique_ptr<int>, ReallocAllocator<std::unique_ptr<int>>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(std::make_unique<int>(i));
+        }
+        assert(*v[SIZE - 1] == SIZE - 1);
+    }
+}
+
+template <typename Growth>
+std::vector<size_t> CollectCapacities(size_t count) {
+    std::vector<size_t> capacities;
+    Vector<int, std::allocator<int>, Growth> v;
+    for (size_t i = 0; i < count; ++i) {
+        v.PushBack(static_cast<int>(i));
+        if (capacities.empty() || capacities.back() != v.Capacity()) {
+            capacities.push_back(v.Capacity());
+        }
+    }
+    return capacities;
+}
+
+void Test10() {
+    {
+        assert((CollectCapacities<DoublingGrowth>(10) == std::vector<size_t>{ 1, 2, 4, 8, 16 }));
+        assert((CollectCapacities<OneAndHalfGrowth>(10) == std::vector<size_t>{ 1, 2, 3, 5, 8, 12 }));
+        assert((CollectCapacities<GoldenRatioGrowth>(10) == std::vector<size_t>{ 1, 2, 3, 4, 6, 9, 14 }));
+        assert((CollectCapacities<FixedStepGrowth<4>>(10) == std::vector<size_t>{ 4, 8, 12 }));
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, OneAndHalfGrowth> v(4);
+        v.Emplace(v.cbegin() + 1, 1);
+        assert(v.Capacity() == 6);
+        assert(v[1].id == 1);
+        assert(Obj::GetAliveObjectCount() == 5);
+    }
+    {
+        // Вместимость округляется до фактического размера блока malloc
+        using Alloc = ReallocAllocator<char>;
+        Vector<char, Alloc> v;
+        v.PushBack('a');
+        assert(v.Capacity() == Alloc().GoodSize(1));
+        assert(v.Capacity() >= 1);
+        v.Reserve(1000);
+        assert(v.Capacity() >= 1000);
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+        for (size_t n : { 1, 7, 24, 25, 100, 1000, 5000 }) {
+            void* p = std::malloc(n);
+            assert(malloc_usable_size(p) == Alloc().GoodSize(n));
+            std::free(p);
+        }
+#endif
+    }
+}
+
+void Test11() {
+    using namespace std::literals;
+    const size_t INLINE_SIZE = 4;
+    {
+        Obj::ResetCounters();
+        {
+            SmallVector<Obj, INLINE_SIZE> v;
+            assert(v.Capacity() == INLINE_SIZE);
+            v.EmplaceBack(1);
+            assert(v.EmplaceBack(2, "two"s).name == "two"s);
+            v.Emplace(v.cbegin(), 0);
+            v.PushBack(Obj{ 3 });
+            assert(v.IsInline());
+            assert(v.Size() == INLINE_SIZE);
+            assert(v[0].id == 0 && v[1].id == 1 && v[2].id == 2 && v[3].id == 3);
+
+            // Копия инлайнового вектора тоже инлайновая
+            SmallVector<Obj, INLINE_SIZE> copy(v);
+            assert(copy.IsInline());
+            assert(copy[3].id == 3);
+
+            v.Insert(v.cbegin() + 2, v[0]);
+            assert(!v.IsInline());
+            assert(v.Size() == INLINE_SIZE + 1);
+            assert(v.Capacity() == INLINE_SIZE * 2);
+            assert(v[2].id == 0 && v[3].id == 2);
+            v.Erase(v.cbegin());
+            assert(v[0].id == 1);
+
+            copy.Swap(v);
+            assert(!copy.IsInline() && v.IsInline());
+            assert(copy.Size() == INLINE_SIZE && v.Size() == INLINE_SIZE);
+            assert(copy[0].id == 1 && v[0].id == 0);
+
+            SmallVector<Obj, INLINE_SIZE> moved(std::move(copy));
+            assert(!moved.IsInline());
+            assert(copy.Size() == 0);
+            moved = v;
+            assert(moved.Size() == INLINE_SIZE);
+            assert(moved[3].id == 3);
+            v = std::move(moved);
+            assert(v.Size() == INLINE_SIZE);
+            v.Resize(1);
+            v.Resize(INLINE_SIZE * 3);
+            assert(v.Size() == INLINE_SIZE * 3);
+            assert(v[0].id == 0);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // Перемещение и обмен инлайновых векторов переносят элементы поштучно
+        Obj::ResetCounters();
+        {
+            SmallVector<Obj, INLINE_SIZE> a;
+            a.EmplaceBack(1);
+            a.EmplaceBack(2);
+            SmallVector<Obj, INLINE_SIZE> moved(std::move(a));
+            assert(moved.IsInline() && moved.Size() == 2 && a.Size() == 0);
+            assert(moved[0].id == 1 && moved[1].id == 2);
+
+            SmallVector<Obj, INLINE_SIZE> b;
+            b.EmplaceBack(3);
+            moved.Swap(b);
+            assert(moved.Size() == 1 && b.Size() == 2);
+            assert(moved[0].id == 3 && b[0].id == 1 && b[1].id == 2);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            SmallVector<Obj, INLINE_SIZE> v(INLINE_SIZE);
+            v[INLINE_SIZE - 1].throw_on_copy = true;
+            try {
+                SmallVector<Obj, INLINE_SIZE> copy(v);
+                assert(false && "Exception is expected");
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(Obj::GetAliveObjectCount() == INLINE_SIZE);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        SmallVector<std::unique_ptr<int>, 2> v;
+        for (int i = 0; i < 10; ++i) {
+            v.Emplace(v.cbegin(), std::make_unique<int>(i));
+        }
+        assert(*v[0] == 9);
+        assert(*v[9] == 0);
+    }
+}
+
+void Test12() {
+    const size_t THRESHOLD = 1 << 20;
+    const size_t LARGE_SIZE = 3 * THRESHOLD / sizeof(uint64_t);
+    using Alloc = HugePageAllocator<uint64_t>;
+    {
+        Vector<uint64_t, Alloc> v(Alloc{ THRESHOLD });
+        v.PushBack(1);
+        for (size_t i = 1; i < LARGE_SIZE; ++i) {
+            v.PushBack(i + 1);
+        }
+        assert(v.Size() == LARGE_SIZE);
+        assert(v[LARGE_SIZE - 1] == LARGE_SIZE);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % Alloc::kHugePageSize == 0);
+        // Вместимость занимает целое число huge pages
+        assert(v.Capacity() * sizeof(uint64_t) % Alloc::kHugePageSize == 0);
+
+        Vector<uint64_t, Alloc> copy(v);
+        assert(copy.GetAllocator() == v.GetAllocator());
+        assert(std::equal(v.begin(), v.end(), copy.begin()));
+    }
+    {
+        Vector<uint64_t, Alloc> v(10, Alloc{ THRESHOLD, HugePageMode::kExplicit });
+        v.Resize(LARGE_SIZE);
+        assert(v[LARGE_SIZE - 1] == 0);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % Alloc::kHugePageSize == 0);
+    }
+}
+
+void Test13() {
+    struct alignas(128) OverAligned {
+        int value = 0;
+    };
+    const size_t SIZE = 1000;
+    {
+        Vector<float, AlignedAllocator<float, 64>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        }
+        // Вместимость кратна 16 float - одному регистру AVX-512
+        assert(v.Capacity() % 16 == 0);
+        v.Reserve(SIZE * 2 + 1);
+        assert(v.Capacity() % 16 == 0);
+        assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        assert(v[SIZE - 1] == static_cast<float>(SIZE - 1));
+    }
+    {
+        Vector<OverAligned> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack().value = static_cast<int>(i);
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % alignof(OverAligned) == 0);
+        }
+        v.Emplace(v.cbegin() + 1);
+        assert(v[2].value == 1);
+
+        SmallVector<OverAligned, 2> small;
+        small.EmplaceBack();
+        assert(reinterpret_cast<uintptr_t>(small.begin()) % alignof(OverAligned) == 0);
+        small.EmplaceBack();
+        small.EmplaceBack();
+        assert(reinterpret_cast<uintptr_t>(small.begin()) % alignof(OverAligned) == 0);
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    {
+        Vector<int> v(SIZE, kDefaultInit);
+        assert(v.Size() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+        v.ResizeUninitialized(SIZE * 3);
+        assert(v.Size() == SIZE * 3);
+        std::fill(v.begin() + SIZE, v.end(), -1);
+        v.ResizeUninitialized(SIZE);
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+    }
+    {
+        Obj::ResetCounters();
+        {
+            Vector<Obj> v(SIZE, kDefaultInit);
+            v.ResizeDefaultInit(SIZE * 2);
+            assert(Obj::num_default_constructed == SIZE * 2);
+            v.ResizeDefaultInit(SIZE / 2);
+            assert(Obj::GetAliveObjectCount() == SIZE / 2);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        Obj::default_construction_throw_countdown = SIZE / 2;
+        Vector<Obj> v(SIZE / 4);
+        try {
+            v.ResizeDefaultInit(SIZE);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE / 4);
+        assert(Obj::GetAliveObjectCount() == SIZE / 4);
+    }
+}
+
+void Test15() {
+    const int SIZE = 10;
+    {
+        Vector<int> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.PushBack(i);
+        }
+        const std::vector<int> values{ -1, -2, -3 };
+        auto* pos = v.Insert(v.cbegin() + 2, values.begin(), values.end());
+        assert(pos == &v[2]);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 0, 1, -1, -2, -3, 2, 3, 4, 5, 6, 7, 8, 9 }));
+        v.Insert(v.cbegin(), { 7, 8 });
+        assert(v[0] == 7 && v[1] == 8 && v[2] == 0);
+        v.Insert(v.cend(), 2, v[0]);
+        assert(v.Size() == SIZE + 7);
+        assert(v[SIZE + 5] == 7 && v[SIZE + 6] == 7);
+        v.Append(values);
+        assert(v[SIZE + 9] == -3);
+
+        std::istringstream input("100 200 300");
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v[1] == 100 && v[2] == 200 && v[3] == 300 && v[4] == 8);
+    }
+    {
+        // Хвост длиннее и короче вставляемого диапазона, вставка без реаллокации
+        for (int shift : { 1, SIZE - 1 }) {
+            Obj::ResetCounters();
+            {
+                Vector<Obj> v(SIZE);
+                v.Reserve(SIZE * 2);
+                Vector<Obj> values(3);
+                for (int i = 0; i < SIZE; ++i) {
+                    v[i].id = i;
+                }
+                values[0].id = -1;
+                values[2].id = -3;
+                v.Insert(v.cbegin() + shift, values.begin(), values.end());
+                assert(v.Capacity() == SIZE * 2);
+                assert(v[shift - 1].id == shift - 1);
+                assert(v[shift].id == -1 && v[shift + 2].id == -3);
+                assert(v[shift + 3].id == shift);
+                assert(v[SIZE + 2].id == SIZE - 1);
+                assert(Obj::num_copied + Obj::num_assigned == 3);
+            }
+            assert(Obj::GetAliveObjectCount() == 0);
+        }
+    }
+    {
+        // Одна реаллокация и перемещение элементов временного диапазона
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        Vector<Obj> values(SIZE * 3);
+        v.Append(std::move(values));
+        assert(v.Size() == SIZE * 4);
+        assert(Obj::num_copied == 0);
+        assert(Obj::num_moved == SIZE + SIZE * 3);
+    }
+    {
+        // При исключении во время копирования вектор не меняется
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        Vector<Obj> values(SIZE);
+        values[SIZE - 1].throw_on_copy = true;
+        try {
+            v.Insert(v.cbegin() + 1, values.begin(), values.end());
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == SIZE * 2);
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        v.Reserve(SIZE);
+        v.EmplaceBack(std::make_unique<int>(1));
+        v.EmplaceBack(std::make_unique<int>(2));
+        std::unique_ptr<int> values[] = { std::make_unique<int>(10), std::make_unique<int>(11) };
+        v.Insert(v.cbegin() + 1, std::make_move_iterator(std::begin(values)), std::make_move_iterator(std::end(values)));
+        assert(*v[0] == 1 && *v[1] == 10 && *v[2] == 11 && *v[3] == 2);
+    }
+}
+
+void Test16() {
+    const int SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (int i = 0; i < SIZE; ++i) {
+            v[i].id = i;
+        }
+        auto* pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == &v[2]);
+        assert(v.Size() == SIZE - 3);
+        assert(v[1].id == 1 && v[2].id == 5 && v[SIZE - 4].id == SIZE - 1);
+        assert(Obj::num_move_assigned == SIZE - 5);
+        assert(Obj::GetAliveObjectCount() == SIZE - 3);
+
+        Obj::ResetCounters();
+        const size_t erased = v.EraseIf([](const Obj& obj) {
+            return obj.id % 2 == 1;
+            });
+        assert(erased == 4);
+        assert(v.Size() == 3);
+        assert(v[0].id == 0 && v[1].id == 6 && v[2].id == 8);
+        assert(Obj::num_move_assigned == 2);
+
+        pos = v.UnorderedErase(v.cbegin());
+        assert(pos->id == 8);
+        assert(v.Size() == 2);
+        v.UnorderedErase(v.cbegin() + 1);
+        assert(v.Size() == 1 && v[0].id == 8);
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(std::make_unique<int>(i));
+        }
+        v.Erase(v.cbegin(), v.cbegin() + 2);
+        assert(*v[0] == 2);
+        assert(v.EraseIf([](const std::unique_ptr<int>& p) {
+            return *p % 3 == 0;
+            }) == 3);
+        assert(v.Size() == SIZE - 5);
+        assert(*v[0] == 2 && *v[1] == 4 && *v[2] == 5 && *v[3] == 7 && *v[4] == 8);
+        v.UnorderedErase(v.cbegin());
+        assert(*v[0] == 8 && v.Size() == SIZE - 6);
+
+        // Исключение в предикате оставляет вектор целым
+        try {
+            v.EraseIf([](const std::unique_ptr<int>& p) {
+                if (*p == 5) {
+                    throw std::runtime_error("Oops");
+                }
+                return *p == 4;
+                });
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE - 7);
+        assert(*v[0] == 8 && *v[1] == 5 && *v[2] == 7);
+    }
+}
+
+void Test17() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 4);
+        v.Resize(SIZE / 2);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2);
+        assert(Obj::num_moved == SIZE + SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == SIZE / 2);
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2);
+
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == SIZE / 2);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.Resize(1);
+        v.ClearAndRelease();
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Vector<int, ReallocAllocator<int>> v(SIZE * 10);
+        v[SIZE - 1] = 42;
+        v.Resize(SIZE);
+        v.ShrinkToFit();
+        assert(v.Capacity() < SIZE * 10 && v.Capacity() >= SIZE);
+        assert(v[SIZE - 1] == 42);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, AutoShrink<>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.Capacity() == 128);
+        v.Erase(v.cbegin(), v.cbegin() + 60);
+        assert(v.Capacity() == 128);
+        auto* pos = v.Erase(v.cbegin() + 1, v.cbegin() + 10);
+        // 31 < 128 / 4: буфер уменьшается до удвоенного размера
+        assert(v.Size() == 31);
+        assert(v.Capacity() == 62);
+        assert(pos == &v[1] && pos->id == 70);
+        while (v.Size() > 1) {
+            v.PopBack();
+        }
+        assert(v.Capacity() <= 4);
+        v.PopBack();
+        assert(v.Capacity() == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // ResizeUninitialized уменьшает буфер так же, как Resize
+        Vector<int, std::allocator<int>, AutoShrink<>> v;
+        v.ResizeUninitialized(128);
+        assert(v.Capacity() == 128);
+        v.ResizeUninitialized(10);
+        assert(v.Size() == 10 && v.Capacity() == 20);
+    }
+    {
+        // Уменьшенная вместимость округляется GoodSize до прежней: буфер не перевыделяется
+        Vector<char, AlignedAllocator<char, 64>, AutoShrink<>> v(64);
+        const char* data = &v[0];
+        while (v.Size() > 1) {
+            v.PopBack();
+            assert(v.Capacity() == 64 && &v[0] == data);
+        }
+    }
+}
+
 struct C {
     C() noexcept {
         ++def_ctor;
@@ -604,45 +1340,1058 @@ struct C {
     inline static size_t dtor = 0;
 };
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-        << ", Copy ctors: "sv << C::copy_ctor          //
-        << ", Move ctors: "sv << C::move_ctor          //
-        << ", Copy assignments: "sv << C::copy_assign  //
-        << ", Move assignments: "sv << C::move_assign  //
-        << ", Dtors: "sv << C::dtor << endl;
-}
+// Vector выполняет столько же конструирований и разрушений элементов, сколько std::vector
+void Test18() {
+    const size_t NUM = 10;
+    C c;
+    {
+        C::Reset();
+        std::vector<C> v(NUM);
+        v.push_back(c);
+    }
+    const size_t std_counts[] = { C::def_ctor, C::copy_ctor, C::move_ctor, C::copy_assign, C::move_assign, C::dtor };
+    {
+        C::Reset();
+        Vector<C> v(NUM);
+        v.PushBack(c);
+    }
+    const size_t our_counts[] = { C::def_ctor, C::copy_ctor, C::move_ctor, C::copy_assign, C::move_assign, C::dtor };
+    assert(std::equal(std::begin(std_counts), std::end(std_counts), std::begin(our_counts)));
+    assert(C::def_ctor == NUM && C::copy_ctor == 1 && C::move_ctor == NUM && C::dtor == NUM * 2 + 1);
+}
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+// Счётчики статистики ведутся только при сборке с -DVECTOR_ENABLE_STATS
+void Test19() {
+    struct MayThrowOnMove {
+        MayThrowOnMove() = default;
+        MayThrowOnMove(const MayThrowOnMove&) = default;
+        MayThrowOnMove(MayThrowOnMove&&) noexcept(false) {
+        }
+    };
+#ifdef VECTOR_ENABLE_STATS
+    const VectorStats before = VectorStatsRegistry::Instance().Totals();
+    {
+        Vector<std::string> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(std::to_string(i));
         }
-        Dump();
+        // Вместимость 1 -> 2 -> 4 -> 8, при трёх ростах перенесено 1 + 2 + 4 элемента
+        const VectorStats& stats = v.Stats();
+        assert(stats.allocations == 4);
+        assert(stats.reallocations == 3);
+        assert(stats.elements_moved == 7 && stats.elements_copied == 0);
+        assert(stats.peak_capacity == 8);
+        assert(stats.bytes_allocated == (1 + 2 + 4 + 8) * sizeof(std::string));
+
+        // Перемещённый вектор уносит статистику с собой
+        Vector<std::string> moved(std::move(v));
+        assert(moved.Stats().allocations == 4 && v.Stats().allocations == 0);
+
+        bool found = false;
+        VectorStatsRegistry::Instance().ForEach([&](const RegisteredVectorStats& entry) {
+            if (&entry.stats == &moved.Stats()) {
+                found = true;
+                assert(entry.element_size == sizeof(std::string));
+            }
+            });
+        assert(found);
+
+        // Копирующее присваивание с ростом учитывает выделение в буфере-приёмнике
+        Vector<std::string> copy;
+        copy = moved;
+        assert(copy.Stats().allocations == 1 && copy.Stats().peak_capacity == moved.Size());
+        copy.ShrinkToFit();
+        assert(copy.Stats().reallocations == 0);
     }
-    catch (...) {
+    {
+        Vector<MayThrowOnMove> v;
+        v.Reserve(2);
+        v.EmplaceBack();
+        v.EmplaceBack();
+        v.Reserve(10);
+        assert(v.Stats().elements_copied == 2 && v.Stats().elements_moved == 0);
+        assert(v.Stats().allocations == 2 && v.Stats().reallocations == 1);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
+    // Статистика уничтоженных векторов сохраняется в реестре
+    const VectorStats after = VectorStatsRegistry::Instance().Totals();
+    assert(after.allocations - before.allocations == 4 + 1 + 2);
+    assert(after.elements_moved - before.elements_moved == 7);
+    assert(after.elements_copied - before.elements_copied == 2);
+#else
+    Vector<MayThrowOnMove> v(3);
+    v.Reserve(10);
+    assert(v.Stats().allocations == 0 && v.Stats().reallocations == 0);
+#endif
+}
+
+void Test20() {
+    struct Record {
+        uint64_t id;
+        double value;
+    };
+    const std::string path = (std::filesystem::temp_directory_path()
+        / ("mapped_vector_test_" + std::to_string(getpid()))).string();
+    std::remove(path.c_str());
+    const size_t SIZE = 10000;
+    {
+        MappedVector<Record> v(path);
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack({ i, i * 0.5 });
+        }
+        v.Resize(v.Capacity());
+        v.Resize(SIZE);
+        // Добавление элемента самого вектора при росте
+        v.PushBack(v[0]);
+        assert(v.Size() == SIZE + 1 && v.Back().id == 0);
+        v.PopBack();
+        v.Sync();
+    }
+    // Файл обрезан до размера вектора и открывается без чтения
+    assert(std::filesystem::file_size(path) == SIZE * sizeof(Record));
+    {
+        MappedVector<Record> v(path);
+        assert(v.Size() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i].id == i && v[i].value == i * 0.5);
+        }
+        v.Resize(SIZE + 10);
+        assert(v[SIZE + 9].id == 0 && v[SIZE + 9].value == 0.0);
+        MappedVector<Record> moved(std::move(v));
+        assert(moved.Size() == SIZE + 10 && v.Size() == 0);
+        moved.Clear();
+    }
+    assert(std::filesystem::file_size(path) == 0);
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        std::fputs("abc", f);
+        std::fclose(f);
+        try {
+            MappedVector<Record> v(path);
+            assert(false);
+        }
+        catch (const std::system_error&) {
+        }
+    }
+    std::remove(path.c_str());
+}
+
+void Test21() {
+    struct Point {
+        int32_t x;
+        int32_t y;
+        double weight;
+    };
+    Vector<Point> points;
+    for (int i = 0; i < 1000; ++i) {
+        points.PushBack(Point{ i, -i, i * 0.25 });
+    }
+    {
+        std::stringstream stream;
+        WriteTo(stream, points);
+        WriteTo(stream, Vector<Point>());
+        assert(stream.str().size() == 2 * sizeof(VectorFileHeader) + points.Size() * sizeof(Point));
+        Vector<Point> loaded(3);
+        ReadFrom(stream, loaded);
+        assert(loaded.Size() == points.Size());
+        assert(std::memcmp(loaded.begin(), points.begin(), points.Size() * sizeof(Point)) == 0);
+        ReadFrom(stream, loaded);
+        assert(loaded.Size() == 0);
+    }
+    {
+        // Тривиально копируемые записи с инициализаторами членов тоже читаются
+        struct Rec {
+            int a = 0;
+            float b = 1.0f;
+        };
+        Vector<Rec> records;
+        for (int i = 0; i < 100; ++i) {
+            records.PushBack(Rec{ i, i * 0.5f });
+        }
+        std::stringstream stream;
+        WriteTo(stream, records);
+        Vector<Rec> loaded;
+        ReadFrom(stream, loaded);
+        assert(loaded.Size() == 100 && loaded[99].a == 99 && loaded[99].b == 49.5f);
+    }
+    {
+        // Повреждённые данные и несовпадающий тип элементов
+        std::stringstream stream;
+        WriteTo(stream, points);
+        std::string bytes = stream.str();
+        bytes[sizeof(VectorFileHeader) + 5] ^= 1;
+        std::stringstream corrupted(bytes);
+        Vector<Point> loaded;
+        try {
+            ReadFrom(corrupted, loaded);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+            assert(loaded.Size() == 0);
+        }
+        std::stringstream other_type(stream.str());
+        Vector<int64_t> wrong;
+        try {
+            ReadFrom(other_type, wrong);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+    }
+    {
+        // Завышенный count в заголовке не приводит к выделению памяти под несуществующие данные
+        std::stringstream stream;
+        WriteTo(stream, points);
+        std::string bytes = stream.str();
+        const uint64_t huge_count = uint64_t(1) << 40;
+        std::memcpy(&bytes[offsetof(VectorFileHeader, count)], &huge_count, sizeof(huge_count));
+        std::stringstream truncated(bytes);
+        Vector<Point> loaded;
+        try {
+            ReadFrom(truncated, loaded);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+            assert(loaded.Size() == 0);
+        }
+
+        const std::string path = (std::filesystem::temp_directory_path()
+            / ("vector_io_truncated_" + std::to_string(getpid()))).string();
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        assert(write(fd, bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()));
+        lseek(fd, 0, SEEK_SET);
+        // Размер обычного файла проверяется до выделения буфера
+        Vector<Point> from_file;
+        try {
+            ReadFrom(fd, from_file);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+            assert(from_file.Capacity() == 0);
+        }
+        close(fd);
+        std::remove(path.c_str());
+    }
+    {
+        const std::string path = (std::filesystem::temp_directory_path()
+            / ("vector_io_test_" + std::to_string(getpid()))).string();
+        const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0);
+        WriteTo(fd, points);
+        lseek(fd, 0, SEEK_SET);
+        Vector<Point> loaded;
+        ReadFrom(fd, loaded);
+        assert(loaded.Size() == points.Size() && loaded[999].y == -999 && loaded[999].weight == 999 * 0.25);
+        close(fd);
+        std::remove(path.c_str());
+    }
+}
+
+void Test22() {
+    {
+        ConcurrentVector<uint64_t> v;
+        const uint64_t& first = v.EmplaceBack(42);
+        const size_t NUM_THREADS = 8;
+        const size_t PER_THREAD = 20000;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&v, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    v.PushBack(t * PER_THREAD + i);
+                }
+                });
+        }
+        // Читатель параллельно с добавлением видит только созданные элементы
+        size_t visible = 0;
+        for (size_t i = 0; i < 1000; ++i) {
+            if (v.IsConstructed(i)) {
+                ++visible;
+            }
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        assert(visible <= 1000);
+        assert(&first == &v[0] && first == 42);
+        assert(v.Size() == NUM_THREADS * PER_THREAD + 1);
+        std::vector<uint64_t> values;
+        v.ForEach([&values](uint64_t value) {
+            values.push_back(value);
+            });
+        values.erase(values.begin());
+        std::sort(values.begin(), values.end());
+        for (size_t i = 0; i < values.size(); ++i) {
+            assert(values[i] == i);
+        }
+        v.Clear();
+        assert(v.Size() == 0);
+        v.PushBack(1);
+        assert(v[0] == 1);
+    }
+    {
+        // Поток, занявший середину сегмента, заранее выделяет следующий, поэтому потоки
+        // почти никогда не выделяют один сегмент одновременно
+        ConcurrentVector<uint64_t, AtomicCountingAllocator<uint64_t>> v;
+        for (uint64_t i = 0; i < 16; ++i) {
+            v.PushBack(i);
+        }
+        assert(AtomicAllocationCounter::num_allocations == 1);
+        v.PushBack(16);
+        assert(AtomicAllocationCounter::num_allocations == 2);
+        const size_t NUM_THREADS = 8;
+        const size_t PER_THREAD = 4000;
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&v] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    v.PushBack(i);
+                }
+                });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        // 32017 элементов занимают сегменты 32, 64, ..., 16384, ещё один выделен заранее.
+        // Проигравший гонку поток лишь выделяет и освобождает лишний сегмент
+        assert(v.Size() == 32017 && AtomicAllocationCounter::num_allocations >= 11);
+    }
+    {
+        // Поток, застрявший в выделении сегмента, не останавливает остальных
+        ConcurrentVector<int, AtomicCountingAllocator<int>> v;
+        AtomicAllocationCounter::stall_next = true;
+        std::thread stalled_thread([&v] {
+            v.PushBack(1);
+            });
+        while (!AtomicAllocationCounter::stalled) {
+            std::this_thread::yield();
+        }
+        std::atomic<bool> done{ false };
+        std::thread other_thread([&v, &done] {
+            v.PushBack(2);
+            done = true;
+            });
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        const bool finished_while_stalled = done;
+        AtomicAllocationCounter::resume = true;
+        stalled_thread.join();
+        other_thread.join();
+        assert(finished_while_stalled);
+        assert(v.Size() == 2 && v.IsConstructed(0) && v.IsConstructed(1) && v[0] + v[1] == 3);
+    }
+    {
+        // Исключение в конструкторе оставляет индекс пустым
+        Obj::ResetCounters();
+        ConcurrentVector<Obj> v;
+        v.EmplaceBack();
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            v.EmplaceBack();
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        v.EmplaceBack();
+        assert(v.Size() == 3 && v.IsConstructed(0) && !v.IsConstructed(1) && v.IsConstructed(2));
+        size_t count = 0;
+        v.ForEach([&count](const Obj&) {
+            ++count;
+            });
+        assert(count == 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test23() {
+    static_assert(DefaultSegmentSize<char>() == 4096 && DefaultSegmentSize<Obj>() >= 16);
+    {
+        // Итераторы остаются действительными, когда таблица блоков переносится при росте
+        SegmentedVector<int, 4> v;
+        v.PushBack(0);
+        auto it = v.begin();
+        const auto cit = v.cbegin();
+        for (int i = 1; i < 200; ++i) {
+            v.PushBack(i);
+        }
+        assert(*it == 0 && *cit == 0 && *(it + 150) == 150 && v.end() - it == 200);
+        *it = -1;
+        assert(v[0] == -1);
+    }
+    Obj::ResetCounters();
+    {
+        SegmentedVector<std::string, 4> v;
+        v.PushBack("first");
+        const std::string* first = &v[0];
+        for (size_t i = 1; i < 100; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        // Рост не переносит элементы
+        assert(first == &v[0] && *first == "first");
+        assert(v.Size() == 100 && v.Capacity() == 100);
+        assert(v[57] == "57" && v.Back() == "99");
+        assert(std::find(v.begin(), v.end(), "42") - v.begin() == 42);
+        assert(std::distance(v.cbegin(), v.cend()) == 100);
+
+        SegmentedVector<std::string, 4>::const_iterator it = v.begin() + 10;
+        assert(*it == "10" && it[5] == "15" && (it + 5) - it == 5 && it < v.end());
+
+        SegmentedVector<std::string, 4> copy = v;
+        assert(copy.Size() == 100 && copy[99] == "99");
+        Vector<std::string> flat = v.ToVector();
+        assert(flat.Size() == 100 && flat[0] == "first" && flat[99] == "99");
+        Vector<std::string> moved = std::move(copy).ToVector();
+        assert(moved.Size() == 100 && moved[50] == "50" && copy.Size() == 0);
+
+        for (size_t i = 0; i < 90; ++i) {
+            v.PopBack();
+        }
+        assert(v.Capacity() == 100);
+        v.ShrinkToFit();
+        assert(v.Size() == 10 && v.Capacity() == 12);
+        v.Clear();
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+    {
+        SegmentedVector<Obj, 8> v;
+        v.Reserve(20);
+        assert(v.Capacity() == 24);
+        v.EmplaceBack();
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            v.EmplaceBack();
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+// Объект со счётчиками, безопасными для параллельного создания
+struct ParallelObj {
+    ParallelObj() {
+        if (throw_countdown.fetch_sub(1) == 1) {
+            throw std::runtime_error("Oops");
+        }
+        ++alive;
+    }
+    ParallelObj(const ParallelObj& other)
+        : value(other.value)
+    {
+        if (throw_countdown.fetch_sub(1) == 1) {
+            throw std::runtime_error("Oops");
+        }
+        ++alive;
+    }
+    ParallelObj& operator=(const ParallelObj&) = default;
+    ~ParallelObj() {
+        --alive;
+    }
+
+    int value = 7;
+
+    inline static std::atomic<int> alive{ 0 };
+    // Исключение бросает создание, на котором счётчик дойдёт до нуля
+    inline static std::atomic<int64_t> throw_countdown{ 0 };
+};
+
+void Test24() {
+    const ParallelPolicy policy{ 4, 1000 };
+    const size_t SIZE = 100000;
+    {
+        Vector<ParallelObj> v(SIZE, policy);
+        assert(v.Size() == SIZE && ParallelObj::alive == int(SIZE));
+        assert(std::all_of(v.begin(), v.end(), [](const ParallelObj& obj) {
+            return obj.value == 7;
+            }));
+        v[SIZE - 1].value = 8;
+        Vector<ParallelObj> copy(v, policy);
+        assert(copy.Size() == SIZE && copy[SIZE - 1].value == 8 && ParallelObj::alive == int(2 * SIZE));
+
+        // Исключение в одной из частей разрушает элементы, созданные во всех частях
+        ParallelObj::throw_countdown = SIZE / 2;
+        try {
+            Vector<ParallelObj> failed(v, policy);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        ParallelObj::throw_countdown = 0;
+        assert(ParallelObj::alive == int(2 * SIZE));
+
+        copy.Clear(policy);
+        assert(copy.Size() == 0 && ParallelObj::alive == int(SIZE));
+    }
+    assert(ParallelObj::alive == 0);
+    {
+        Vector<std::string> strings(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            strings[i] = std::to_string(i);
+        }
+        Vector<std::string> copy(strings, kParallel);
+        assert(std::equal(strings.begin(), strings.end(), copy.begin()));
+        // Малые векторы обрабатываются в вызывающем потоке
+        assert(kParallel.ChunkCount(10) == 1 && policy.ChunkCount(SIZE) == 4);
+    }
+}
+
+void Test25() {
+    using Alloc = NumaAllocator<double>;
+    const size_t SIZE = size_t(1) << 20;
+    // Политика применяется, если ядро её поддерживает; иначе память выделяется как обычно
+    for (const Alloc& alloc : { Alloc(), Alloc(NumaPolicy::kDefault), Alloc::OnNode(0),
+        Alloc(NumaPolicy::kPreferred, 1) })
+    {
+        Vector<double, Alloc> v(alloc);
+        v.Resize(SIZE, ParallelPolicy{ 4, 1 << 16 });
+        assert(v.Size() == SIZE);
+        assert(std::all_of(v.begin(), v.end(), [](double x) {
+            return x == 0.0;
+            }));
+        v[SIZE - 1] = 1.5;
+        v.Resize(SIZE / 2, kParallel);
+        assert(v.Size() == SIZE / 2);
+        assert(v.GetAllocator().GetPolicy() == alloc.GetPolicy());
+    }
+    {
+        // Малые блоки выделяются без mmap
+        Vector<int, NumaAllocator<int>> v(NumaAllocator<int>(NumaPolicy::kInterleave));
+        v.PushBack(1);
+        v.PushBack(2);
+        assert(v[1] == 2);
+        static_assert(std::is_same_v<decltype(v)::allocator_type, NumaAllocator<int>>);
+    }
+    assert(Alloc::OnNode(63).GetNodeMask() == uint64_t(1) << 63);
+    {
+        // Маска с последним узлом передаётся ядру целиком
+        Vector<double, Alloc> v(Alloc(NumaPolicy::kPreferred, uint64_t(1) << 63 | 1));
+        v.Resize(SIZE);
+        assert(v.Size() == SIZE && v[SIZE - 1] == 0.0);
+    }
+}
+
+void Test26() {
+    {
+        // Рост при копирующем присваивании выделяет память ровно один раз
+        using Alloc = CountingAllocator<int, false>;
+        Vector<int, Alloc> source(100);
+        for (size_t i = 0; i < source.Size(); ++i) {
+            source[i] = static_cast<int>(i);
+        }
+        Vector<int, Alloc> target(10);
+        const int allocations = Alloc::num_allocations;
+        target = source;
+        assert(Alloc::num_allocations == allocations + 1);
+        assert(target.Size() == 100 && target[99] == 99);
+
+        // Присваивание в пределах вместимости не выделяет памяти
+        Vector<int, Alloc> small(5);
+        target = small;
+        assert(target.Size() == 5 && target[4] == 0 && target.Capacity() == 100);
+        target = source;
+        assert(Alloc::num_allocations == allocations + 2);
+        assert(target.Size() == 100 && target[50] == 50);
+    }
+    {
+        // Исключение при росте оставляет вектор прежним
+        Obj::ResetCounters();
+        Vector<Obj> source(10);
+        source[9].throw_on_copy = true;
+        Vector<Obj> target(2);
+        target[0].id = 42;
+        try {
+            target = source;
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(target.Size() == 2 && target[0].id == 42);
+        source[9].throw_on_copy = false;
+        target = source;
+        assert(target.Size() == 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test27() {
+    Obj::ResetCounters();
+    {
+        SoAVector<int, std::string, double> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i, std::to_string(i), i * 2.0);
+        }
+        assert(v.Size() == 100 && v.Capacity() >= 100);
+
+        // Столбцы непрерывны и обходятся независимо от остальных полей
+        ColumnSpan<double> weights = v.Column<2>();
+        assert(weights.Size() == 100 && weights.Data() + 99 == &weights[99]);
+        double sum = 0;
+        for (double w : weights) {
+            sum += w;
+        }
+        assert(sum == 99 * 100);
+
+        // Прокси-ссылка на строку
+        auto row = v[10];
+        assert(row.Get<0>() == 10 && row.Get<1>() == "10" && row.Get<2>() == 20.0);
+        row.Get<1>() = "ten";
+        v[11] = std::make_tuple(-11, std::string("minus eleven"), -22.0);
+        assert(v.Column<1>()[10] == "ten" && v.Column<0>()[11] == -11);
+        const std::tuple<int, std::string, double> value = v[11];
+        assert(std::get<1>(value) == "minus eleven");
+
+        // Добавление строки, поля которой ссылаются на элементы того же вектора
+        v.Reserve(v.Size());
+        v.EmplaceBack(v.Column<0>()[0], v.Column<1>()[10], v.Column<2>()[99]);
+        assert(v.Size() == 101 && v[100].Get<1>() == "ten" && v[100].Get<2>() == 198.0);
+
+        v.Erase(0);
+        assert(v.Size() == 100 && v[0].Get<0>() == 1 && v[0].Get<1>() == "1" && v[99].Get<1>() == "ten");
+        v.PopBack();
+
+        const SoAVector<int, std::string, double> copy = v;
+        assert(copy.Size() == 99 && copy[9].Get<1>() == "ten" && copy.Column<2>()[98] == 198.0);
+        SoAVector<int, std::string, double> moved = std::move(v);
+        assert(moved.Size() == 99 && v.Size() == 0);
+        v.PushBack(std::make_tuple(1, std::string("one"), 1.0));
+        assert(v.Size() == 1 && v[0].Get<1>() == "one");
+    }
+    {
+        // Исключение при копировании столбца во время роста оставляет вектор прежним
+        struct ThrowingCopy {
+            explicit ThrowingCopy(int value)
+                : value(value)
+            {
+            }
+            ThrowingCopy(const ThrowingCopy& other)
+                : value(other.value)
+            {
+                if (value < 0) {
+                    throw std::runtime_error("Oops");
+                }
+            }
+            ThrowingCopy(ThrowingCopy&& other) noexcept(false)
+                : ThrowingCopy(static_cast<const ThrowingCopy&>(other))
+            {
+            }
+            ThrowingCopy& operator=(const ThrowingCopy& other)
+            {
+                if (other.value < 0) {
+                    throw std::runtime_error("Oops");
+                }
+                value = other.value;
+                return *this;
+            }
+
+            int value;
+        };
+        SoAVector<Obj, ThrowingCopy> v;
+        v.Reserve(2);
+        v.EmplaceBack(1, ThrowingCopy(1));
+        v.EmplaceBack(2, ThrowingCopy(2));
+        v[1].Get<1>().value = -1;
+        try {
+            v.EmplaceBack(3, ThrowingCopy(3));
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 2 && v.Capacity() == 2 && v[1].Get<0>().id == 2);
+        assert(Obj::GetAliveObjectCount() == 2);
+        v[1].Get<1>().value = 2;
+        v.EmplaceBack(3, ThrowingCopy(3));
+        assert(v.Size() == 3 && v[2].Get<0>().id == 3 && v[1].Get<1>().value == 2);
+
+        // Исключение при сдвиге столбца во время Erase не разрушает элементы других столбцов
+        v[1].Get<1>().value = -1;
+        try {
+            v.Erase(0);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 3 && Obj::GetAliveObjectCount() == 3);
+        v[1].Get<1>().value = 2;
+        v.Erase(0);
+        assert(v.Size() == 2 && Obj::GetAliveObjectCount() == 2 && v[1].Get<1>().value == 3);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test28() {
+    // Вставки и удаления в разных позициях сверяются с std::vector<bool>
+    BitVector bits;
+    std::vector<bool> expected;
+    uint64_t state = 1;
+    auto next = [&state] {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state >> 33;
+    };
+    for (size_t i = 0; i < 3000; ++i) {
+        const bool value = next() % 3 == 0;
+        const uint64_t op = next() % 4;
+        if (op == 0 && !expected.empty()) {
+            const size_t pos = next() % expected.size();
+            bits.Erase(pos);
+            expected.erase(expected.begin() + pos);
+        }
+        else if (op == 1) {
+            const size_t pos = next() % (expected.size() + 1);
+            bits.Insert(pos, value);
+            expected.insert(expected.begin() + pos, value);
+        }
+        else {
+            bits.PushBack(value);
+            expected.push_back(value);
+        }
+    }
+    assert(bits.Size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        assert(bits[i] == expected[i]);
+    }
+    assert(bits.Count() == size_t(std::count(expected.begin(), expected.end(), true)));
+    Vector<size_t> set_bits;
+    bits.ForEachSetBit([&set_bits](size_t index) {
+        set_bits.PushBack(index);
+        });
+    assert(set_bits.Size() == bits.Count());
+    size_t pos = bits.FindFirst();
+    for (size_t index : set_bits) {
+        assert(pos == index && expected[index]);
+        pos = bits.FindNext(pos);
+    }
+    assert(pos == BitVector::npos);
+
+    // Массовые операции
+    const size_t SIZE = 1000;
+    BitVector a(SIZE);
+    BitVector b(SIZE, true);
+    for (size_t i = 0; i < SIZE; i += 3) {
+        a.Set(i);
+    }
+    assert(a.Count() == 334 && b.Count() == SIZE);
+    BitVector c = a;
+    c &= b;
+    assert(c == a);
+    c ^= b;
+    assert(c.Count() == SIZE - 334 && !c[0] && c[1]);
+    c |= a;
+    assert(c == b);
+    c.Flip();
+    assert(c.Count() == 0 && !c.Any() && c.FindFirst() == BitVector::npos);
+    c.Set(999);
+    assert(c.FindFirst() == 999 && c.FindNext(999) == BitVector::npos);
+    a.Flip(0);
+    assert(!a[0] && a.Count() == 333);
+
+    b.Resize(1030, false);
+    assert(b.Count() == SIZE && !b[1029]);
+    b.Resize(10);
+    b.Resize(100, true);
+    assert(b.Count() == 100);
+    b.Erase(0);
+    assert(b.Size() == 99 && b.Count() == 99 && b.WordCount() == 2 && (b.Words()[1] >> 35) == 0);
+    b.PopBack();
+    b.Clear();
+    assert(b.Size() == 0 && b.Count() == 0);
+}
+
+void Test29() {
+    // Каждый доступный набор инструкций сверяется с алгоритмами std на размерах,
+    // не кратных ширине регистра, и с искомым элементом в разных позициях
+    const SimdLevel detected = DetectSimdLevel();
+    for (SimdLevel level : { SimdLevel::kScalar, SimdLevel::kSse42, SimdLevel::kAvx2, SimdLevel::kAvx512 }) {
+        if (level > detected) {
+            break;
+        }
+        assert(SetSimdLevel(level) == level && ActiveSimdLevel() == level);
+        for (size_t size : { 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 100, 1000 }) {
+            Vector<int32_t> ints(size);
+            Vector<float> floats(size);
+            for (size_t i = 0; i < size; ++i) {
+                ints[i] = static_cast<int32_t>((i * 7919) % 101) - 50;
+                floats[i] = static_cast<float>(ints[i]) / 4;
+            }
+            for (size_t pos : { size_t(0), size / 2, size - 1 }) {
+                ints[pos] = 1000;
+                floats[pos] = 1000.0f;
+                const size_t first = std::find(ints.begin(), ints.end(), 1000) - ints.begin();
+                assert(IndexOf(ints, 1000) == first && IndexOf(floats, 1000.0f) == first);
+                assert(Find(ints, 1000) == ints.begin() + first && *Find(floats, 1000.0f) == 1000.0f);
+                assert(Contains(ints, 1000) && Contains(floats, 1000.0f));
+                assert(Count(ints, 1000) == size_t(std::count(ints.begin(), ints.end(), 1000)));
+                assert(Count(floats, 1000.0f) == Count(ints, 1000));
+            }
+            assert(IndexOf(ints, 2000) == kNotFound && Find(ints, 2000) == ints.end() && !Contains(floats, 0.1f));
+            assert(Count(ints, -50) == size_t(std::count(ints.begin(), ints.end(), -50)));
+
+            ints[size - 1] = -3000;
+            floats[size - 1] = -3000.0f;
+            const auto [int_min, int_max] = std::minmax_element(ints.begin(), ints.end());
+            assert(MinMax(ints) == std::make_pair(*int_min, *int_max));
+            const auto [float_min, float_max] = std::minmax_element(floats.begin(), floats.end());
+            assert(MinMax(floats) == std::make_pair(*float_min, *float_max));
+        }
+        // NaN не равен ничему, -0.0 равен 0.0
+        Vector<float> special;
+        special.PushBack(std::numeric_limits<float>::quiet_NaN());
+        special.PushBack(-0.0f);
+        for (int i = 1; i < 20; ++i) {
+            special.PushBack(static_cast<float>(i));
+        }
+        assert(!Contains(special, std::numeric_limits<float>::quiet_NaN()));
+        assert(IndexOf(special, 0.0f) == 1 && Count(special, 0.0f) == 1);
+    }
+    SetSimdLevel(detected);
+
+    // Остальные типы ищутся алгоритмами std
+    Vector<std::string> strings;
+    for (const char* s : { "a", "b", "c", "b" }) {
+        strings.PushBack(s);
+    }
+    assert(IndexOf(strings, std::string("b")) == 1 && Count(strings, std::string("b")) == 2);
+    assert(MinMax(strings) == std::make_pair(std::string("a"), std::string("c")));
+    const int64_t longs[] = { 5, -1, 9 };
+    assert(IndexOf(longs, 3, int64_t(9)) == 2 && MinMax(longs, 3) == std::make_pair(int64_t(-1), int64_t(9)));
+}
+
+void Test30() {
+    // Поиск без ветвлений совпадает с std::lower_bound на всех размерах и позициях
+    {
+        Vector<int> keys;
+        for (int size = 0; size < 40; ++size) {
+            for (int key = -1; key <= 2 * size + 1; ++key) {
+                const size_t expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+                assert(flat_map_detail::LowerBound(keys.begin(), keys.Size(), key, std::less<>()) == expected);
+            }
+            keys.PushBack(2 * size);
+        }
+    }
+
+    // Случайные вставки и удаления сверяются с std::map
+    {
+        FlatMap<int, std::string> map;
+        std::map<int, std::string> expected;
+        uint64_t state = 1;
+        auto next = [&state] {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<int>((state >> 33) % 200);
+        };
+        for (int i = 0; i < 2000; ++i) {
+            const int key = next();
+            const std::string value = std::to_string(i);
+            switch (next() % 4) {
+            case 0:
+                assert(map.Insert(key, value).second == expected.emplace(key, value).second);
+                break;
+            case 1:
+                assert(map.InsertOrAssign(key, value).second == expected.insert_or_assign(key, value).second);
+                break;
+            case 2:
+                assert(map.Erase(key) == expected.erase(key));
+                break;
+            default:
+                assert(map[key] == expected[key]);
+                break;
+            }
+        }
+        assert(map.Size() == expected.size());
+        auto it = expected.begin();
+        for (const auto& [key, value] : map) {
+            assert(key == it->first && value == it->second);
+            ++it;
+        }
+        for (int key = 0; key < 200; ++key) {
+            assert(map.Contains(key) == (expected.count(key) == 1));
+            const std::string* value = map.Find(key);
+            assert(value == nullptr ? expected.count(key) == 0 : *value == expected.at(key));
+        }
+        try {
+            map.At(1000);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+    }
+
+    // Пакетная вставка: существующие ключи и первые из повторов сохраняют значения
+    {
+        FlatMap<int, int> map;
+        map.Insert(5, 50);
+        map.Insert(1, 10);
+        const std::pair<int, int> batch[] = { { 7, 70 }, { 3, 30 }, { 5, 0 }, { 3, 0 }, { 0, 0 }, { 9, 90 } };
+        map.InsertBulk(std::begin(batch), std::end(batch));
+        const int keys[] = { 0, 1, 3, 5, 7, 9 };
+        const int values[] = { 0, 10, 30, 50, 70, 90 };
+        assert(map.Size() == 6);
+        assert(std::equal(map.Keys().begin(), map.Keys().end(), keys));
+        assert(std::equal(map.Values().begin(), map.Values().end(), values));
+
+        FlatSet<int> set(std::begin(keys), std::end(keys));
+        const int more[] = { 4, 2, 9, 4, -1 };
+        set.InsertBulk(std::begin(more), std::end(more));
+        const int set_keys[] = { -1, 0, 1, 2, 3, 4, 5, 7, 9 };
+        assert(set.Size() == 9 && std::equal(set.begin(), set.end(), set_keys));
+        assert(!set.Insert(4).second && set.Insert(6).second && *set.Find(6) == 6);
+        assert(set.Erase(0) == 1 && set.Erase(0) == 0 && *set.LowerBound(0) == 1);
+    }
+
+    // Поиск строк по std::string_view и const char* без создания std::string
+    {
+        FlatMap<std::string, int> map;
+        map["banana"] = 2;
+        map["apple"] = 1;
+        map.Emplace(std::string_view("cherry"), 3);
+        assert(map.At(std::string_view("apple")) == 1 && map.Contains("banana") && !map.Contains("date"));
+        assert(*map.Find(std::string_view("cherry")) == 3 && map.Erase("banana") == 1);
+
+        FlatSet<std::string> set;
+        set.Insert("b");
+        set.Insert(std::string("a"));
+        assert(set.Contains(std::string_view("a")) && set.Find("c") == set.end());
+
+        // Непрозрачный компаратор задаёт порядок
+        FlatSet<int, std::greater<int>> descending;
+        for (int key : { 1, 3, 2 }) {
+            descending.Insert(key);
+        }
+        assert(*descending.begin() == 3 && descending.Contains(2));
+    }
+
+    // Исключение при пакетной вставке оставляет словарь прежним
+    {
+        Obj::ResetCounters();
         {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+            FlatMap<int, Obj> map;
+            map.Emplace(1, 1);
+            Vector<std::pair<int, Obj>> batch;
+            batch.EmplaceBack(2, Obj(2));
+            batch.EmplaceBack(0, Obj(0));
+            batch[1].second.throw_on_copy = true;
+            try {
+                map.InsertBulk(batch.begin(), batch.end());
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(map.Size() == 1 && map.At(1).id == 1);
         }
-        Dump();
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+
+    // Значение с бросающим перемещением: ключи копируются вместе со значениями,
+    // и исключение не оставляет в словаре перемещённых ключей
+    {
+        struct ThrowingValue {
+            explicit ThrowingValue(int v)
+                : value(v)
+            {
+            }
+            ThrowingValue(const ThrowingValue& other)
+                : value(other.value)
+            {
+                if (other.value < 0) {
+                    throw std::runtime_error("Oops");
+                }
+            }
+            ThrowingValue& operator=(const ThrowingValue&) = default;
+
+            int value;
+        };
+        FlatMap<std::string, ThrowingValue> map;
+        map.Emplace(std::string("a"), 1);
+        map.Emplace(std::string("b"), -1);
+        const std::pair<std::string, ThrowingValue> batch[] = { { "c", ThrowingValue(3) } };
+        try {
+            map.InsertBulk(std::begin(batch), std::end(batch));
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(map.Size() == 2 && map.Contains("a") && map.Contains("b"));
+        assert(map.At("a").value == 1 && map.At("b").value == -1);
+    }
+}
+
+void Test31() {
+    // Отдельные выделения: место возвращается и расширяется только у последнего
+    {
+        Arena arena(1024);
+        char* a = static_cast<char*>(arena.Allocate(10, 1));
+        char* b = static_cast<char*>(arena.Allocate(100, 64));
+        assert(reinterpret_cast<uintptr_t>(b) % 64 == 0 && b >= a + 10);
+        assert(!arena.TryResize(a, 10, 20) && arena.TryResize(b, 100, 200));
+        arena.Deallocate(b, 200);
+        assert(arena.Allocate(100, 64) == b);
+        arena.Deallocate(a, 10);
+        assert(arena.Allocate(8, 1) != a);
+
+        // Выделение больше блока получает свой блок, Reset оставляет только последний блок
+        char* big = static_cast<char*>(arena.Allocate(5000));
+        std::memset(big, 1, 5000);
+        assert(arena.BytesReserved() >= 1024 + 5000);
+        const size_t last_block = arena.BytesReserved() - 1024;
+        arena.Reset();
+        assert(arena.BytesReserved() == last_block && arena.BytesUsedInBlock() == 0);
+        assert(arena.Allocate(16) == big);
+        arena.Release();
+        assert(arena.BytesReserved() == 0);
     }
-    catch (...) {
+
+    // Вектор, растущий последним, расширяет буфер на месте
+    {
+        Arena arena;
+        Vector<int, ArenaAllocator<int>> v(arena);
+        v.PushBack(0);
+        const int* data = v.begin();
+        for (int i = 1; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.begin() == data && v.Capacity() >= 1000);
+        for (int i = 0; i < 1000; ++i) {
+            assert(v[i] == i);
+        }
+
+        // Векторы, растущие поочерёдно, переносятся копированием
+        Vector<int, ArenaAllocator<int>> a(arena);
+        Vector<int, ArenaAllocator<int>> b(arena);
+        for (int i = 0; i < 500; ++i) {
+            a.PushBack(i);
+            b.PushBack(-i);
+        }
+        for (int i = 0; i < 500; ++i) {
+            assert(a[i] == i && b[i] == -i);
+        }
+        a.ShrinkToFit();
+        assert(a.Size() == 500 && a[499] == 499);
+
+        Vector<int, ArenaAllocator<int>> copy = v;
+        assert(copy.Size() == 1000 && copy[999] == 999 && copy.GetAllocator() == v.GetAllocator());
+    }
+
+    // Элементы, которые не переносятся побайтово, и std::pmr
+    {
+        Arena arena(256);
+        Obj::ResetCounters();
+        {
+            Vector<Obj, ArenaAllocator<Obj>> v(arena);
+            for (int i = 0; i < 100; ++i) {
+                v.EmplaceBack(i, std::string(40, 'x'));
+            }
+            assert(v.Size() == 100 && v[99].id == 99 && v[99].name.size() == 40);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+
+        std::pmr::vector<std::pmr::string> strings(&arena);
+        for (int i = 0; i < 100; ++i) {
+            strings.emplace_back(std::to_string(i) + std::string(40, 'y'));
+        }
+        assert(strings[42].substr(0, 2) == "42");
     }
 }
 
@@ -654,7 +2403,31 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,260 @@
+#pragma once
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "vector.h"
+
+// Вектор, элементы которого хранятся в файле, отображённом в память через mmap (MAP_SHARED).
+// Открытие файла не читает его: страницы подгружаются по обращению и разделяются через кеш
+// страниц между процессами, отображающими тот же файл. При росте файл увеличивается через
+// ftruncate и отображается заново, при закрытии обрезается до размера вектора.
+// Элементы хранятся в файле побайтово, поэтому тип должен быть тривиально копируемым.
+// Ошибки системных вызовов сообщаются исключением std::system_error
+template <typename T, typename Growth = DoublingGrowth>
+class MappedVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores elements as raw bytes");
+
+    // Открывает файл path, создавая его при отсутствии. Размер вектора равен длине файла,
+    // делённой на sizeof(T)
+    explicit MappedVector(const std::string& path)
+        : fd_(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644))
+    {
+        if (fd_ < 0) {
+            ThrowSystemError("open " + path);
+        }
+        struct stat st;
+        if (fstat(fd_, &st) != 0) {
+            const int error = errno;
+            close(fd_);
+            throw std::system_error(error, std::generic_category(), "fstat " + path);
+        }
+        const size_t bytes = static_cast<size_t>(st.st_size);
+        if (bytes % sizeof(T) != 0) {
+            close(fd_);
+            throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                path + ": file size is not a multiple of the element size");
+        }
+        try {
+            Map(bytes / sizeof(T));
+        }
+        catch (...) {
+            close(fd_);
+            throw;
+        }
+        size_ = capacity_;
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , data_(std::exchange(other.data_, nullptr))
+        , size_(std::exchange(other.size_, 0))
+        , capacity_(std::exchange(other.capacity_, 0))
+    {
+    }
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            Close();
+            fd_ = std::exchange(rhs.fd_, -1);
+            data_ = std::exchange(rhs.data_, nullptr);
+            size_ = std::exchange(rhs.size_, 0);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~MappedVector()
+    {
+        Close();
+    }
+
+    // Записывает изменённые страницы на диск и дожидается завершения записи
+    void Sync()
+    {
+        if (capacity_ != 0 && msync(data_, capacity_ * sizeof(T), MS_SYNC) != 0) {
+            ThrowSystemError("msync");
+        }
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity > capacity_) {
+            Remap(new_capacity);
+        }
+    }
+
+    // Новые элементы заполнены нулями: так ftruncate расширяет файл
+    void Resize(size_t new_size)
+    {
+        if (new_size > size_) {
+            Reserve(new_size);
+            // Хвост за размером мог остаться от удалённых элементов
+            std::memset(static_cast<void*>(data_ + size_), 0, (new_size - size_) * sizeof(T));
+        }
+        size_ = new_size;
+    }
+
+    void PushBack(const T& value)
+    {
+        if (size_ == capacity_) {
+            // value может ссылаться на элемент вектора, а Remap перемещает отображение
+            const T copy = value;
+            Remap(Growth::NextCapacity(capacity_, size_ + 1));
+            data_[size_] = copy;
+        }
+        else {
+            data_[size_] = value;
+        }
+        ++size_;
+    }
+
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        --size_;
+    }
+
+    // Удаляет все элементы; файл будет обрезан при закрытии
+    void Clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    T& Back() noexcept
+    {
+        assert(size_ > 0);
+        return data_[size_ - 1];
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<MappedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    iterator begin() noexcept {
+        return data_;
+    }
+    iterator end() noexcept {
+        return data_ + size_;
+    }
+    const_iterator begin() const noexcept {
+        return data_;
+    }
+    const_iterator end() const noexcept {
+        return data_ + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    [[noreturn]] static void ThrowSystemError(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Отображает первые capacity элементов файла
+    void Map(size_t capacity)
+    {
+        if (capacity != 0) {
+            void* p = mmap(nullptr, capacity * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (p == MAP_FAILED) {
+                ThrowSystemError("mmap");
+            }
+            data_ = static_cast<T*>(p);
+        }
+        capacity_ = capacity;
+    }
+
+    // Увеличивает файл до new_capacity элементов и перестраивает отображение
+    void Remap(size_t new_capacity)
+    {
+        if (new_capacity > size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t new_bytes = new_capacity * sizeof(T);
+        if (ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0) {
+            ThrowSystemError("ftruncate");
+        }
+        if (capacity_ == 0) {
+            Map(new_capacity);
+            return;
+        }
+#ifdef __linux__
+        void* p = mremap(data_, capacity_ * sizeof(T), new_bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            ThrowSystemError("mremap");
+        }
+        data_ = static_cast<T*>(p);
+        capacity_ = new_capacity;
+#else
+        // Старое отображение снимается только после успешного создания нового
+        void* p = mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            ThrowSystemError("mmap");
+        }
+        munmap(data_, capacity_ * sizeof(T));
+        data_ = static_cast<T*>(p);
+        capacity_ = new_capacity;
+#endif
+    }
+
+    // Снимает отображение и обрезает файл до размера вектора. Ошибки игнорируются:
+    // данные уже находятся в кеше страниц, для гарантии записи на диск служит Sync
+    void Close() noexcept
+    {
+        if (fd_ < 0) {
+            return;
+        }
+        if (capacity_ != 0) {
+            munmap(data_, capacity_ * sizeof(T));
+        }
+        if (size_ != capacity_) {
+            [[maybe_unused]] const int result = ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T)));
+        }
+        close(fd_);
+        fd_ = -1;
+        data_ = nullptr;
+        size_ = capacity_ = 0;
+    }
+
+    int fd_ = -1;
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -0,0 +1,166 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Размещение страниц по узлам NUMA
+enum class NumaPolicy {
+    // Политика процесса: страница достаётся узлу потока, первым её коснувшегося
+    kDefault,
+    // Страницы распределяются по узлам маски поочерёдно
+    kInterleave,
+    // Страницы размещаются только на узлах маски
+    kBind,
+    // Страницы размещаются на узлах маски, пока там есть память
+    kPreferred,
+};
+
+// Аллокатор, назначающий блокам от threshold байт политику NUMA через системный вызов mbind.
+// Библиотека libnuma не нужна; если ядро не поддерживает NUMA или политика не применяется,
+// память остаётся с политикой по умолчанию. Такие блоки выделяются через mmap, так как политика
+// задаётся для целых страниц. Блоки меньше порога выделяются обычным operator new.
+// С kDefault размещение определяется первым касанием, поэтому большой вектор стоит
+// инициализировать параллельно: Vector::Resize(n, ParallelPolicy)
+template <typename T>
+class NumaAllocator {
+public:
+    using value_type = T;
+
+    static constexpr size_t kDefaultThreshold = size_t(1) << 20;
+    // Все узлы, доступные процессу (ядро пересекает маску с разрешёнными узлами)
+    static constexpr uint64_t kAllNodes = ~uint64_t(0);
+    // Маска описывает узлы 0..kMaxNodes-1
+    static constexpr unsigned kMaxNodes = 64;
+
+    explicit NumaAllocator(NumaPolicy policy = NumaPolicy::kInterleave, uint64_t node_mask = kAllNodes,
+        size_t threshold = kDefaultThreshold) noexcept
+        : policy_(policy)
+        , node_mask_(node_mask)
+        , threshold_(threshold)
+    {
+    }
+
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U>& other) noexcept
+        : policy_(other.GetPolicy())
+        , node_mask_(other.GetNodeMask())
+        , threshold_(other.GetThreshold())
+    {
+    }
+
+    // Блок только на узле node < kMaxNodes. Для узла вне маски политика не применяется
+    static NumaAllocator OnNode(unsigned node) noexcept
+    {
+        assert(node < kMaxNodes);
+        return NumaAllocator(NumaPolicy::kBind, node < kMaxNodes ? uint64_t(1) << node : 0);
+    }
+
+    T* allocate(size_t n) {
+        if (n > size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            return static_cast<T*>(operator new(bytes, std::align_val_t(alignof(T))));
+        }
+        return static_cast<T*>(Map(bytes));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            operator delete(p, std::align_val_t(alignof(T)));
+            return;
+        }
+#ifdef __linux__
+        munmap(p, bytes);
+#endif
+    }
+
+    NumaPolicy GetPolicy() const noexcept {
+        return policy_;
+    }
+
+    uint64_t GetNodeMask() const noexcept {
+        return node_mask_;
+    }
+
+    size_t GetThreshold() const noexcept {
+        return threshold_;
+    }
+
+    // Способ освобождения зависит только от порога
+    bool operator==(const NumaAllocator& other) const noexcept {
+        return threshold_ == other.threshold_;
+    }
+    bool operator!=(const NumaAllocator& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    bool IsMapped(size_t bytes) const noexcept {
+#ifdef __linux__
+        return bytes != 0 && bytes >= threshold_;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    void* Map(size_t bytes) const {
+#ifdef __linux__
+        void* p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        ApplyPolicy(p, bytes);
+        return p;
+#else
+        (void)bytes;
+        throw std::bad_alloc();
+#endif
+    }
+
+#ifdef __linux__
+    // Ошибка не критична: страницы будут размещены по политике процесса
+    void ApplyPolicy(void* p, size_t bytes) const noexcept {
+#ifdef SYS_mbind
+        // Значения MPOL_* из <linux/mempolicy.h>
+        constexpr int kMpolPreferred = 1;
+        constexpr int kMpolBind = 2;
+        constexpr int kMpolInterleave = 3;
+        int mode = 0;
+        switch (policy_) {
+        case NumaPolicy::kDefault:
+            return;
+        case NumaPolicy::kInterleave:
+            mode = kMpolInterleave;
+            break;
+        case NumaPolicy::kBind:
+            mode = kMpolBind;
+            break;
+        case NumaPolicy::kPreferred:
+            mode = kMpolPreferred;
+            break;
+        }
+        const unsigned long mask = static_cast<unsigned long>(node_mask_);
+        // Ядро читает maxnode - 1 бит маски
+        syscall(SYS_mbind, p, bytes, mode, &mask, sizeof(mask) * 8 + 1, 0);
+#else
+        (void)p;
+        (void)bytes;
+#endif
+    }
+#endif
+
+    NumaPolicy policy_;
+    uint64_t node_mask_;
+    size_t threshold_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <new>
+#include <thread>
+
+// Параметры параллельного выполнения массовых операций над элементами вектора.
+// Диапазон делится на части не меньше min_chunk элементов, по одной на поток
+struct ParallelPolicy {
+    // Число потоков, 0 - std::thread::hardware_concurrency()
+    size_t threads = 0;
+    size_t min_chunk = size_t(1) << 15;
+
+    size_t ChunkCount(size_t count) const noexcept
+    {
+        size_t max_threads = threads != 0 ? threads : std::thread::hardware_concurrency();
+        max_threads = std::max<size_t>(max_threads, 1);
+        const size_t by_size = count / std::max<size_t>(min_chunk, 1);
+        return std::max<size_t>(std::min(max_threads, by_size), 1);
+    }
+};
+
+inline constexpr ParallelPolicy kParallel{};
+
+// Выполняет run(begin, end) для частей [0, count) в отдельных потоках; первая часть выполняется
+// в вызывающем потоке. Если run выбросил исключение, для успешно выполненных частей вызывается
+// rollback(begin, end), после чего исключение пробрасывается дальше. rollback не должен
+// выбрасывать исключений. Если поток не удалось создать, часть выполняется в вызывающем потоке,
+// а если не хватило памяти на служебные массивы - весь диапазон. Собственных исключений
+// ParallelFor не выбрасывает, поэтому с не выбрасывающим run он безопасен в noexcept-функциях
+template <typename Run, typename Rollback>
+void ParallelFor(size_t count, const ParallelPolicy& policy, Run run, Rollback rollback)
+{
+    const size_t chunks = policy.ChunkCount(count);
+    if (chunks == 1) {
+        run(size_t(0), count);
+        return;
+    }
+    auto chunk_begin = [count, chunks](size_t chunk) {
+        return count / chunks * chunk + std::min(chunk, count % chunks);
+    };
+    std::unique_ptr<std::exception_ptr[]> errors(new (std::nothrow) std::exception_ptr[chunks]);
+    std::unique_ptr<std::thread[]> threads(new (std::nothrow) std::thread[chunks]);
+    if (errors == nullptr || threads == nullptr) {
+        run(size_t(0), count);
+        return;
+    }
+    auto run_chunk = [&](size_t chunk) noexcept {
+        try {
+            run(chunk_begin(chunk), chunk_begin(chunk + 1));
+        }
+        catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        try {
+            threads[chunk] = std::thread(run_chunk, chunk);
+        }
+        catch (...) {
+            run_chunk(chunk);
+        }
+    }
+    run_chunk(0);
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        if (threads[chunk].joinable()) {
+            threads[chunk].join();
+        }
+    }
+
+    const std::exception_ptr* failed = std::find_if(errors.get(), errors.get() + chunks,
+        [](const std::exception_ptr& error) {
+            return error != nullptr;
+        });
+    if (failed == errors.get() + chunks) {
+        return;
+    }
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (errors[chunk] == nullptr) {
+            rollback(chunk_begin(chunk), chunk_begin(chunk + 1));
+        }
+    }
+    std::rethrow_exception(*failed);
+}
+
+// ParallelFor для операций, которые не выбрасывают исключений
+template <typename Run>
+void ParallelFor(size_t count, const ParallelPolicy& policy, Run run) noexcept
+{
+    ParallelFor(count, policy, run, [](size_t, size_t) noexcept {
+        });
+}
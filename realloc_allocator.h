@@ -0,0 +1,173 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// Аллокатор на основе malloc/realloc/free. Блоки размером от MmapThreshold байт выделяются
+// напрямую через mmap и растут через mremap, поэтому ядро может расширить отображение на месте
+// или перенести страницы без копирования. Vector использует его метод Reallocate для
+// тривиально перемещаемых элементов, избегая копирования и двойного пика памяти при росте
+template <typename T, size_t MmapThreshold = (size_t(1) << 20)>
+class ReallocAllocator {
+public:
+    using value_type = T;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not guarantee alignment of T");
+
+    template <typename U>
+    struct rebind {
+        using other = ReallocAllocator<U, MmapThreshold>;
+    };
+
+    ReallocAllocator() noexcept = default;
+
+    template <typename U>
+    ReallocAllocator(const ReallocAllocator<U, MmapThreshold>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(AllocateBytes(ToBytes(n)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        DeallocateBytes(p, n * sizeof(T));
+    }
+
+    // Меняет размер блока p с old_n до new_n элементов, сохраняя min(old_n, new_n) первых из них.
+    // При нехватке памяти выбрасывает std::bad_alloc, оставляя блок p нетронутым
+    T* Reallocate(T* p, size_t old_n, size_t new_n) {
+        if (p == nullptr || old_n == 0) {
+            return allocate(new_n);
+        }
+        if (new_n == 0) {
+            deallocate(p, old_n);
+            return nullptr;
+        }
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = ToBytes(new_n);
+        if (IsMapped(old_bytes) == IsMapped(new_bytes)) {
+            return static_cast<T*>(ResizeBytes(p, old_bytes, new_bytes));
+        }
+        // Блок переходит между malloc и mmap - копируем содержимое вручную
+        void* new_p = AllocateBytes(new_bytes);
+        std::memcpy(new_p, static_cast<const void*>(p), old_bytes < new_bytes ? old_bytes : new_bytes);
+        DeallocateBytes(p, old_bytes);
+        return static_cast<T*>(new_p);
+    }
+
+    // Округляет число элементов вверх до того, что реально выделится под запрос n элементов
+    size_t GoodSize(size_t n) const noexcept {
+        if (n == 0 || n > size_t(-1) / sizeof(T)) {
+            return n;
+        }
+        const size_t bytes = n * sizeof(T);
+#ifdef __linux__
+        if (IsMapped(bytes)) {
+            return PageAlign(bytes) / sizeof(T);
+        }
+#endif
+#ifdef __GLIBC__
+        // Чанк glibc malloc состоит из заголовка size_t и полезной части, выровнен по
+        // MALLOC_ALIGNMENT и не меньше четырёх size_t. Полезной памяти на size_t меньше чанка
+        constexpr size_t header = sizeof(size_t);
+        constexpr size_t alignment = alignof(std::max_align_t);
+        const size_t chunk = std::max(4 * header, (bytes + header + alignment - 1) & ~(alignment - 1));
+        // Блок не должен дорасти до порога mmap, иначе deallocate освободит его через munmap
+        const size_t usable = std::min(chunk - header, MmapThreshold - 1);
+        return std::max(n, usable / sizeof(T));
+#else
+        return n;
+#endif
+    }
+
+    bool operator==(const ReallocAllocator& /*other*/) const noexcept {
+        return true;
+    }
+    bool operator!=(const ReallocAllocator& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static size_t ToBytes(size_t n) {
+        if (n > size_t(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    static bool IsMapped(size_t bytes) noexcept {
+#ifdef __linux__
+        return bytes >= MmapThreshold;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+#ifdef __linux__
+    static size_t PageAlign(size_t bytes) noexcept {
+        static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page_size - 1) & ~(page_size - 1);
+    }
+#endif
+
+    static void* AllocateBytes(size_t bytes) {
+        void* p = nullptr;
+#ifdef __linux__
+        if (IsMapped(bytes)) {
+            p = mmap(nullptr, PageAlign(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return p;
+        }
+#endif
+        p = std::malloc(bytes);
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+
+    static void* ResizeBytes(void* p, size_t old_bytes, size_t new_bytes) {
+        void* new_p = nullptr;
+#ifdef __linux__
+        if (IsMapped(new_bytes)) {
+            new_p = mremap(p, PageAlign(old_bytes), PageAlign(new_bytes), MREMAP_MAYMOVE);
+            if (new_p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            return new_p;
+        }
+#else
+        (void)old_bytes;
+#endif
+        new_p = std::realloc(p, new_bytes);
+        if (new_p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return new_p;
+    }
+
+    static void DeallocateBytes(void* p, size_t bytes) noexcept {
+        if (p == nullptr) {
+            return;
+        }
+#ifdef __linux__
+        if (IsMapped(bytes)) {
+            munmap(p, PageAlign(bytes));
+            return;
+        }
+#else
+        (void)bytes;
+#endif
+        std::free(p);
+    }
+};
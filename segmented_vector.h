@@ -0,0 +1,360 @@
+#pragma once
+#include "vector.h"
+
+// Число элементов в блоке SegmentedVector по умолчанию: степень двойки, при которой блок
+// занимает около 4 КиБ, но не меньше 16 элементов
+template <typename T>
+constexpr size_t DefaultSegmentSize() noexcept {
+    size_t size = 16;
+    while (size * sizeof(T) < 4096) {
+        size *= 2;
+    }
+    return size;
+}
+
+// Вектор из блоков фиксированного размера ChunkSize (степень двойки), как std::deque, но только
+// с добавлением в конец. Элементы никогда не переносятся: рост выделяет новый блок и дописывает
+// указатель на него в таблицу, поэтому время добавления не зависит от размера, а ссылки и
+// итераторы на элементы остаются действительными. Доступ по индексу - сдвиг и маска.
+// Для передачи в код, ожидающий непрерывный буфер, служит ToVector
+template <typename T, size_t ChunkSize = DefaultSegmentSize<T>(), typename Alloc = std::allocator<T>>
+class SegmentedVector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    using ChunkTable = Vector<T*, typename AllocTraits::template rebind_alloc<T*>>;
+
+    static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+    // Итератор хранит вектор и индекс, а блок ищет при разыменовании: таблица блоков
+    // переносится при росте, и указатель на неё устарел бы
+    template <bool IsConst>
+    class Iterator {
+        using Container = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        Iterator() = default;
+
+        Iterator(Container* container, size_t index) noexcept
+            : container_(container)
+            , index_(index)
+        {
+        }
+
+        // Неконстантный итератор приводится к константному
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : container_(other.container_)
+            , index_(other.index_)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return container_->chunks_[index_ / ChunkSize][index_ % ChunkSize];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+        reference operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+        Iterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        friend Iterator operator+(difference_type n, Iterator it) noexcept {
+            return it += n;
+        }
+        friend Iterator operator-(Iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+        bool operator<(const Iterator& other) const noexcept {
+            return index_ < other.index_;
+        }
+        bool operator>(const Iterator& other) const noexcept {
+            return index_ > other.index_;
+        }
+        bool operator<=(const Iterator& other) const noexcept {
+            return index_ <= other.index_;
+        }
+        bool operator>=(const Iterator& other) const noexcept {
+            return index_ >= other.index_;
+        }
+
+    private:
+        friend class Iterator<!IsConst>;
+
+        Container* container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using allocator_type = Alloc;
+
+    static constexpr size_t kChunkSize = ChunkSize;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Alloc& alloc)
+        : alloc_(alloc)
+        , chunks_(typename ChunkTable::allocator_type(alloc))
+    {
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(AllocTraits::select_on_container_copy_construction(other.alloc_))
+    {
+        Reserve(other.size_);
+        for (const T& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : alloc_(other.alloc_)
+        , chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    ~SegmentedVector()
+    {
+        Clear();
+        ReleaseChunks(0);
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs)
+    {
+        if (this != &rhs) {
+            SegmentedVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            SegmentedVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    // Блоки разных аллокаторов нельзя обменять, если аллокатор не распространяется при обмене
+    void Swap(SegmentedVector& other) noexcept
+    {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        else {
+            assert(alloc_ == other.alloc_);
+        }
+        chunks_.Swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        if (size_ == Capacity()) {
+            AddChunk();
+        }
+        T* p = SlotAt(size_);
+        AllocTraits::construct(alloc_, p, std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    template <typename Type>
+    void PushBack(Type&& value)
+    {
+        EmplaceBack(std::forward<Type>(value));
+    }
+
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        --size_;
+        AllocTraits::destroy(alloc_, SlotAt(size_));
+    }
+
+    // Удаляет все элементы, оставляя выделенные блоки для повторного использования
+    void Clear() noexcept
+    {
+        while (size_ != 0) {
+            PopBack();
+        }
+    }
+
+    // Освобождает блоки, не занятые элементами
+    void ShrinkToFit() noexcept
+    {
+        ReleaseChunks((size_ + ChunkSize - 1) / ChunkSize);
+    }
+
+    // Выделяет блоки под new_capacity элементов
+    void Reserve(size_t new_capacity)
+    {
+        const size_t chunk_count = (new_capacity + ChunkSize - 1) / ChunkSize;
+        chunks_.Reserve(chunk_count);
+        while (chunks_.Size() < chunk_count) {
+            AddChunk();
+        }
+    }
+
+    T& Back() noexcept
+    {
+        assert(size_ > 0);
+        return (*this)[size_ - 1];
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkSize;
+    }
+
+    Alloc GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return *SlotAt(index);
+    }
+
+    // Копирует элементы в непрерывный Vector, блок за блоком
+    Vector<T, Alloc> ToVector() const&
+    {
+        Vector<T, Alloc> result(alloc_);
+        AppendChunksTo(result, [](T* first) {
+            return first;
+            });
+        return result;
+    }
+
+    // Перемещает элементы в непрерывный Vector; сам SegmentedVector остаётся пустым
+    Vector<T, Alloc> ToVector() &&
+    {
+        Vector<T, Alloc> result(alloc_);
+        AppendChunksTo(result, [](T* first) {
+            return std::make_move_iterator(first);
+            });
+        Clear();
+        return result;
+    }
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    // Место элемента index в выделенных блоках, без проверки на размер
+    T* SlotAt(size_t index) noexcept
+    {
+        return chunks_[index / ChunkSize] + index % ChunkSize;
+    }
+
+    void AddChunk()
+    {
+        T* chunk = AllocTraits::allocate(alloc_, ChunkSize);
+        try {
+            chunks_.PushBack(chunk);
+        }
+        catch (...) {
+            AllocTraits::deallocate(alloc_, chunk, ChunkSize);
+            throw;
+        }
+    }
+
+    // Освобождает блоки, начиная с блока keep. Блоки должны быть пусты
+    void ReleaseChunks(size_t keep) noexcept
+    {
+        while (chunks_.Size() > keep) {
+            AllocTraits::deallocate(alloc_, chunks_.Back(), ChunkSize);
+            chunks_.PopBack();
+        }
+    }
+
+    // Дописывает в result элементы всех блоков; make_iterator(first) задаёт способ переноса
+    template <typename MakeIterator>
+    void AppendChunksTo(Vector<T, Alloc>& result, MakeIterator make_iterator) const
+    {
+        result.Reserve(size_);
+        for (size_t first = 0; first < size_; first += ChunkSize) {
+            T* chunk = chunks_[first / ChunkSize];
+            const size_t count = std::min(ChunkSize, size_ - first);
+            result.Insert(result.cend(), make_iterator(chunk), make_iterator(chunk + count));
+        }
+    }
+
+    Alloc alloc_;
+    // Таблица блоков растёт как Vector, но переносит только указатели
+    ChunkTable chunks_;
+    size_t size_ = 0;
+};
@@ -0,0 +1,352 @@
+#pragma once
+#include "vector.h"
+
+// Вектор, хранящий до N элементов во встроенном буфере без обращения к куче.
+// При превышении N элементы переносятся в RawMemory и дальше вектор растёт как Vector.
+// Интерфейс и гарантии безопасности исключений совпадают с Vector
+template <typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Alloc;
+
+    static_assert(N > 0, "Use Vector for containers without inline storage");
+
+    SmallVector() = default;
+
+    explicit SmallVector(const Alloc& alloc) noexcept
+        : heap_(alloc)
+    {
+    }
+
+    SmallVector(size_t size, const Alloc& alloc = Alloc())
+        : heap_(size > N ? size : 0, alloc)
+    {
+        heap_.UninitializedValueConstructN(data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other)
+        : heap_(other.size_ > N ? other.size_ : 0,
+            std::allocator_traits<Alloc>::select_on_container_copy_construction(other.heap_.GetAllocator()))
+    {
+        heap_.UninitializedCopyN(other.data(), other.size_, data());
+        size_ = other.size_;
+    }
+
+    // Встроенные элементы перемещаются поштучно, буфер в куче забирается целиком
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : heap_(other.heap_.GetAllocator())
+    {
+        if (other.IsInline()) {
+            heap_.UninitializedMoveN(other.data(), other.size_, data());
+            size_ = other.size_;
+            other.Clear();
+        }
+        else {
+            heap_.Swap(other.heap_);
+            size_ = std::exchange(other.size_, 0);
+        }
+    }
+
+    ~SmallVector()
+    {
+        heap_.DestroyN(data(), size_);
+    }
+
+    SmallVector& operator=(const SmallVector& rhs)
+    {
+        if (this != &rhs) {
+            if (rhs.size_ > Capacity()) {
+                RawMemory<T, Alloc> new_data(rhs.size_, heap_.GetAllocator());
+                new_data.UninitializedCopyN(rhs.data(), rhs.size_, new_data.GetAddress());
+                heap_.DestroyN(data(), size_);
+                heap_.Swap(new_data);
+            }
+            else if (rhs.size_ < size_) {
+                std::copy(rhs.begin(), rhs.end(), begin());
+                heap_.DestroyN(data() + rhs.size_, size_ - rhs.size_);
+            }
+            else {
+                std::copy(rhs.begin(), rhs.begin() + size_, begin());
+                heap_.UninitializedCopyN(rhs.data() + size_, rhs.size_ - size_, data() + size_);
+            }
+            size_ = rhs.size_;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>
+        && std::is_nothrow_move_assignable_v<T>)
+    {
+        if (this != &rhs) {
+            if (!rhs.IsInline()) {
+                heap_.DestroyN(data(), size_);
+                heap_ = std::move(rhs.heap_);
+                size_ = std::exchange(rhs.size_, 0);
+                return *this;
+            }
+            // rhs.size_ <= N <= Capacity(), поэтому элементы помещаются в текущий буфер
+            if (rhs.size_ < size_) {
+                std::move(rhs.begin(), rhs.end(), begin());
+                heap_.DestroyN(data() + rhs.size_, size_ - rhs.size_);
+            }
+            else {
+                std::move(rhs.begin(), rhs.begin() + size_, begin());
+                heap_.UninitializedMoveN(rhs.data() + size_, rhs.size_ - size_, data() + size_);
+            }
+            size_ = rhs.size_;
+            rhs.Clear();
+        }
+        return *this;
+    }
+
+    void Swap(SmallVector& other)
+    {
+        if (!IsInline() && !other.IsInline()) {
+            heap_.Swap(other.heap_);
+            std::swap(size_, other.size_);
+            return;
+        }
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    void Resize(size_t new_size)
+    {
+        if (new_size < size_) {
+            heap_.DestroyN(data() + new_size, size_ - new_size);
+        }
+        else if (new_size > size_) {
+            Reserve(new_size);
+            heap_.UninitializedValueConstructN(data() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, heap_.GetAllocator());
+        heap_.UninitializedRelocateN(data(), size_, new_data.GetAddress());
+        heap_.Swap(new_data);
+    }
+
+    template <typename Type>
+    void PushBack(Type&& value)
+    {
+        EmplaceBack(std::forward<Type>(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args)
+    {
+        if (size_ == Capacity()) {
+            RawMemory<T, Alloc> new_data(GrowCapacity(), heap_.GetAllocator());
+            // Новый элемент создаётся до переноса старых: args могут ссылаться на элементы вектора
+            new_data.Construct(new_data + size_, std::forward<Args>(args)...);
+            try {
+                heap_.UninitializedRelocateN(data(), size_, new_data.GetAddress());
+            }
+            catch (...) {
+                new_data.Destroy(new_data + size_);
+                throw;
+            }
+            heap_.Swap(new_data);
+        }
+        else {
+            heap_.Construct(data() + size_, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return Back();
+    }
+
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args)
+    {
+        assert(pos >= begin() && pos <= end());
+        const size_t shift = pos - cbegin();
+
+        if (shift == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + shift;
+        }
+        if (size_ == Capacity()) {
+            RawMemory<T, Alloc> new_data(GrowCapacity(), heap_.GetAllocator());
+            T* new_elem = new_data + shift;
+            new_data.Construct(new_elem, std::forward<Args>(args)...);
+            if constexpr (kIsTriviallyRelocatable<T>) {
+                heap_.UninitializedRelocateN(data(), shift, new_data.GetAddress());
+                heap_.UninitializedRelocateN(data() + shift, size_ - shift, new_elem + 1);
+            }
+            else {
+                try {
+                    new_data.UninitializedMoveIfNoexceptN(data(), shift, new_data.GetAddress());
+                }
+                catch (...) {
+                    new_data.Destroy(new_elem);
+                    throw;
+                }
+                try {
+                    new_data.UninitializedMoveIfNoexceptN(data() + shift, size_ - shift, new_elem + 1);
+                }
+                catch (...) {
+                    new_data.DestroyN(new_data.GetAddress(), shift + 1);
+                    throw;
+                }
+                heap_.DestroyN(data(), size_);
+            }
+            heap_.Swap(new_data);
+            ++size_;
+            return new_elem;
+        }
+
+        // Временное значение создаётся заранее, так как args могут ссылаться на элементы вектора
+        alignas(T) unsigned char new_value_buf[sizeof(T)];
+        T* new_value = reinterpret_cast<T*>(new_value_buf);
+        heap_.Construct(new_value, std::forward<Args>(args)...);
+        T* first = data() + shift;
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            std::memmove(static_cast<void*>(first + 1), static_cast<const void*>(first), (size_ - shift) * sizeof(T));
+            std::memcpy(static_cast<void*>(first), static_cast<const void*>(new_value), sizeof(T));
+        }
+        else {
+            try {
+                heap_.Construct(end(), std::move(*std::prev(end())));
+            }
+            catch (...) {
+                heap_.Destroy(new_value);
+                throw;
+            }
+            try {
+                std::move_backward(first, std::prev(end()), end());
+                *first = std::move(*new_value);
+            }
+            catch (...) {
+                heap_.Destroy(end());
+                heap_.Destroy(new_value);
+                throw;
+            }
+            heap_.Destroy(new_value);
+        }
+        ++size_;
+        return first;
+    }
+
+    iterator Erase(const_iterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+        iterator it = begin() + (pos - cbegin());
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            heap_.Destroy(it);
+            std::memmove(static_cast<void*>(it), static_cast<const void*>(it + 1), (end() - it - 1) * sizeof(T));
+        }
+        else {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                std::move(it + 1, end(), it);
+            }
+            else {
+                std::copy(it + 1, end(), it);
+            }
+            heap_.Destroy(std::prev(end()));
+        }
+        --size_;
+        return it;
+    }
+
+    iterator Insert(const_iterator pos, const T& value)
+    {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value)
+    {
+        return Emplace(pos, std::move(value));
+    }
+
+    void PopBack()
+    {
+        assert(size_ > 0);
+        heap_.Destroy(data() + size_ - 1);
+        --size_;
+    }
+
+    void Clear() noexcept
+    {
+        heap_.DestroyN(data(), size_);
+        size_ = 0;
+    }
+
+    T& Back()
+    {
+        assert(size_ > 0);
+        return data()[size_ - 1];
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    // Элементы хранятся во встроенном буфере
+    bool IsInline() const noexcept {
+        return heap_.Capacity() == 0;
+    }
+
+    Alloc GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data()[index];
+    }
+
+    iterator begin() noexcept {
+        return data();
+    }
+    iterator end() noexcept {
+        return data() + size_;
+    }
+    const_iterator begin() const noexcept {
+        return data();
+    }
+    const_iterator end() const noexcept {
+        return data() + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    T* data() noexcept {
+        return IsInline() ? reinterpret_cast<T*>(inline_buffer_) : heap_.GetAddress();
+    }
+
+    const T* data() const noexcept {
+        return const_cast<SmallVector&>(*this).data();
+    }
+
+    size_t GrowCapacity() const noexcept {
+        return DoublingGrowth::NextCapacity(Capacity(), size_ + 1);
+    }
+
+    // Пустой, пока элементы помещаются во встроенный буфер
+    RawMemory<T, Alloc> heap_;
+    size_t size_ = 0;
+    alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+};
@@ -0,0 +1,361 @@
+#pragma once
+#include <tuple>
+
+#include "vector.h"
+
+// Непрерывный диапазон элементов одного столбца SoAVector
+template <typename T>
+class ColumnSpan {
+public:
+    using value_type = std::remove_const_t<T>;
+    using iterator = T*;
+
+    ColumnSpan(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size)
+    {
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    iterator begin() const noexcept {
+        return data_;
+    }
+    iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+// Вектор строк из полей Fields..., где каждое поле хранится в отдельном непрерывном массиве
+// (struct of arrays). Цикл по одному-двум полям читает только их столбцы и не тратит кеш на
+// остальные поля, а столбец можно обрабатывать векторными инструкциями (Column<I>).
+// Все столбцы имеют общую вместимость. Строка доступна через прокси-ссылку operator[].
+// При росте столбцы, перенос которых может выбросить исключение, копируются первыми,
+// поэтому исключение оставляет вектор прежним
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+    using Indices = std::index_sequence_for<Fields...>;
+    using Columns = std::tuple<RawMemory<Fields>...>;
+
+    // Перенос столбца копированием: элементы нельзя переместить без риска исключения
+    template <typename T>
+    static constexpr bool kRelocationMayThrow = !kIsTriviallyRelocatable<T> && !std::is_nothrow_move_constructible_v<T>;
+
+public:
+    using value_type = std::tuple<Fields...>;
+
+    // Прокси-ссылка на строку: кортеж ссылок на поля в столбцах
+    template <bool IsConst>
+    class RowReference {
+    public:
+        using Refs = std::conditional_t<IsConst, std::tuple<const Fields&...>, std::tuple<Fields&...>>;
+
+        explicit RowReference(const Refs& fields) noexcept
+            : fields_(fields)
+        {
+        }
+
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        RowReference(const RowReference<OtherConst>& other) noexcept
+            : fields_(other.fields_)
+        {
+        }
+
+        template <size_t I>
+        auto& Get() const noexcept {
+            return std::get<I>(fields_);
+        }
+
+        operator value_type() const {
+            return value_type(fields_);
+        }
+
+        // Присваивание полям строки значений из row
+        const RowReference& operator=(const value_type& row) const {
+            static_assert(!IsConst, "Cannot assign through a const row reference");
+            Refs fields = fields_;
+            fields = row;
+            return *this;
+        }
+
+    private:
+        friend class RowReference<!IsConst>;
+
+        Refs fields_;
+    };
+
+    using reference = RowReference<false>;
+    using const_reference = RowReference<true>;
+
+    SoAVector() = default;
+
+    SoAVector(const SoAVector& other)
+        : columns_(RawMemory<Fields>(other.size_)...)
+    {
+        CopyColumns(other, Indices{});
+        size_ = other.size_;
+    }
+
+    SoAVector(SoAVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    ~SoAVector()
+    {
+        Clear();
+    }
+
+    SoAVector& operator=(const SoAVector& rhs)
+    {
+        if (this != &rhs) {
+            SoAVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& rhs) noexcept
+    {
+        if (this != &rhs) {
+            SoAVector moved(std::move(rhs));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    void Swap(SoAVector& other) noexcept
+    {
+        SwapColumns(other.columns_, Indices{});
+        std::swap(size_, other.size_);
+    }
+
+    // Добавляет строку, поле I которой создаётся из args[I]
+    template <typename... Args>
+    reference EmplaceBack(Args&&... args)
+    {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "EmplaceBack takes one argument per field");
+        if (size_ == Capacity()) {
+            // args могут ссылаться на элементы вектора, поэтому строка создаётся до переноса
+            value_type row(std::forward<Args>(args)...);
+            ChangeCapacity(DoublingGrowth::NextCapacity(Capacity(), size_ + 1), Indices{});
+            ConstructRow(std::move(row), Indices{});
+        }
+        else {
+            ConstructRow(std::forward_as_tuple(std::forward<Args>(args)...), Indices{});
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void PushBack(const value_type& row)
+    {
+        std::apply([this](const Fields&... fields) {
+            EmplaceBack(fields...);
+            }, row);
+    }
+
+    // Удаляет строку index, сдвигая следующие. Если сдвиг поля выбросил исключение,
+    // размер не меняется и все строки остаются живыми, но их поля могут быть сдвинуты
+    void Erase(size_t index)
+    {
+        assert(index < size_);
+        EraseRow(index, Indices{});
+        --size_;
+    }
+
+    void PopBack() noexcept
+    {
+        assert(size_ > 0);
+        --size_;
+        DestroyRows(size_, 1, Indices{});
+    }
+
+    void Clear() noexcept
+    {
+        DestroyRows(0, size_, Indices{});
+        size_ = 0;
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity > Capacity()) {
+            ChangeCapacity(new_capacity, Indices{});
+        }
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return MakeRow(index, Indices{});
+    }
+
+    const_reference operator[](size_t index) const noexcept {
+        return const_cast<SoAVector&>(*this)[index];
+    }
+
+    // Элементы поля I всех строк
+    template <size_t I>
+    ColumnSpan<Field<I>> Column() noexcept {
+        return ColumnSpan<Field<I>>(std::get<I>(columns_).GetAddress(), size_);
+    }
+
+    template <size_t I>
+    ColumnSpan<const Field<I>> Column() const noexcept {
+        return ColumnSpan<const Field<I>>(std::get<I>(columns_).GetAddress(), size_);
+    }
+
+private:
+    template <size_t... I>
+    reference MakeRow(size_t index, std::index_sequence<I...>) noexcept {
+        return reference(std::tie(*(std::get<I>(columns_) + index)...));
+    }
+
+    template <size_t... I>
+    void SwapColumns(Columns& other, std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns_).Swap(std::get<I>(other)), ...);
+    }
+
+    template <size_t... I>
+    void DestroyRows(size_t first, size_t count, std::index_sequence<I...>) noexcept {
+        (std::get<I>(columns_).DestroyN(std::get<I>(columns_) + first, count), ...);
+    }
+
+    template <size_t... I>
+    void CopyColumns(const SoAVector& other, std::index_sequence<I...>)
+    {
+        bool copied[sizeof...(Fields)] = {};
+        try {
+            ((std::get<I>(columns_).UninitializedCopyN(std::get<I>(other.columns_).GetAddress(), other.size_,
+                std::get<I>(columns_).GetAddress()), copied[I] = true), ...);
+        }
+        catch (...) {
+            ((copied[I] ? std::get<I>(columns_).DestroyN(std::get<I>(columns_).GetAddress(), other.size_) : void()), ...);
+            throw;
+        }
+    }
+
+    // Создаёт поля строки size_ из элементов кортежа values
+    template <typename Tuple, size_t... I>
+    void ConstructRow(Tuple&& values, std::index_sequence<I...>)
+    {
+        bool constructed[sizeof...(Fields)] = {};
+        try {
+            ((std::get<I>(columns_).Construct(std::get<I>(columns_) + size_, std::get<I>(std::forward<Tuple>(values))),
+                constructed[I] = true), ...);
+        }
+        catch (...) {
+            ((constructed[I] ? std::get<I>(columns_).Destroy(std::get<I>(columns_) + size_) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void ChangeCapacity(size_t new_capacity, std::index_sequence<I...>)
+    {
+        Columns new_columns{ RawMemory<Fields>(new_capacity)... };
+        // Сначала копируются столбцы, перенос которых может выбросить исключение: исходные
+        // элементы при этом не меняются, и при ошибке достаточно разрушить копии
+        bool copied[sizeof...(Fields)] = {};
+        try {
+            (CopyColumnIfMayThrow<I>(new_columns, copied[I]), ...);
+        }
+        catch (...) {
+            ((copied[I] ? std::get<I>(new_columns).DestroyN(std::get<I>(new_columns).GetAddress(), size_) : void()), ...);
+            throw;
+        }
+        // Остальные столбцы переносятся без исключений
+        (RelocateColumnIfNoexcept<I>(new_columns), ...);
+        SwapColumns(new_columns, Indices{});
+    }
+
+    template <size_t I>
+    void CopyColumnIfMayThrow(Columns& new_columns, bool& copied)
+    {
+        if constexpr (kRelocationMayThrow<Field<I>>) {
+            std::get<I>(new_columns).UninitializedMoveIfNoexceptN(std::get<I>(columns_).GetAddress(), size_,
+                std::get<I>(new_columns).GetAddress());
+            copied = true;
+        }
+    }
+
+    template <size_t I>
+    void RelocateColumnIfNoexcept(Columns& new_columns) noexcept
+    {
+        if constexpr (kRelocationMayThrow<Field<I>>) {
+            std::get<I>(columns_).DestroyN(std::get<I>(columns_).GetAddress(), size_);
+        }
+        else {
+            std::get<I>(columns_).UninitializedRelocateN(std::get<I>(columns_).GetAddress(), size_,
+                std::get<I>(new_columns).GetAddress());
+        }
+    }
+
+    // Сначала сдвигаются столбцы, где сдвиг присваиванием может выбросить исключение. Если
+    // это произошло, ни один элемент ещё не разрушен и размер прежний: строки остаются живыми,
+    // но часть столбцов уже сдвинута (базовая гарантия). Дальше исключений нет: остальные
+    // столбцы сдвигаются memmove, а последние элементы сдвинутых столбцов разрушаются
+    template <size_t... I>
+    void EraseRow(size_t index, std::index_sequence<I...>)
+    {
+        (ShiftColumn<I>(index), ...);
+        (FinishColumnErase<I>(index), ...);
+    }
+
+    template <size_t I>
+    void ShiftColumn(size_t index)
+    {
+        using T = Field<I>;
+        if constexpr (!kIsTriviallyRelocatable<T>) {
+            RawMemory<T>& column = std::get<I>(columns_);
+            std::move(column + (index + 1), column + size_, column + index);
+        }
+    }
+
+    template <size_t I>
+    void FinishColumnErase(size_t index) noexcept
+    {
+        using T = Field<I>;
+        RawMemory<T>& column = std::get<I>(columns_);
+        T* last = column + (size_ - 1);
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            T* position = column + index;
+            column.Destroy(position);
+            std::memmove(static_cast<void*>(position), static_cast<const void*>(position + 1),
+                (last - position) * sizeof(T));
+        }
+        else {
+            column.Destroy(last);
+        }
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
@@ -1,23 +1,73 @@
 #pragma once
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <new>
 #include <utility>
 #include <memory>
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
+#ifdef VECTOR_ENABLE_STATS
+#include <typeinfo>
+#endif
+
+#include "parallel.h"
+#include "vector_stats.h"
+
+// Тип тривиально перемещаем, если перенос объекта в другое место памяти с последующим
+// "забыванием" исходного объекта эквивалентен memcpy. Такие объекты при реаллокации и сдвигах
+// переносятся побайтово, без вызова конструкторов перемещения и деструкторов.
+// Тривиально копируемые типы определяются автоматически, остальные можно отметить специализацией
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {
+};
+
+template <typename T>
+struct IsTriviallyRelocatable<std::unique_ptr<T>> : std::true_type {
+};
 
 template <typename T>
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+// Аллокатор может предоставить метод T* Reallocate(T* p, size_t old_n, size_t new_n), который
+// меняет размер блока с сохранением содержимого (как realloc). Он используется для роста буфера
+// тривиально перемещаемых элементов
+template <typename Alloc, typename = void>
+struct HasReallocate : std::false_type {
+};
+
+template <typename Alloc>
+struct HasReallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().Reallocate(
+    std::declval<typename std::allocator_traits<Alloc>::pointer>(), size_t{}, size_t{}))>> : std::true_type {
+};
+
+template <typename T, typename Alloc = std::allocator<T>>
 class RawMemory {
 public:
+    using allocator_type = Alloc;
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+        "Alloc::value_type must be the same as T");
+
+    static constexpr bool kCanReallocate = HasReallocate<Alloc>::value;
+
     RawMemory() = default;
 
+    explicit RawMemory(const Alloc& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
     RawMemory(RawMemory&& other) noexcept
+        : alloc_(std::move(other.alloc_))
     {
-        buffer_ = std::move(other.buffer_);
-        capacity_ = std::move(other.capacity_);
+        buffer_ = other.buffer_;
+        capacity_ = other.capacity_;
 
         other.buffer_ = nullptr;
         other.capacity_ = 0;
@@ -26,8 +76,16 @@ public:
     {
         if (this != &rhs)
         {
-            buffer_ = std::move(rhs.buffer_);
-            capacity_ = std::move(rhs.capacity_);
+            Deallocate(buffer_, capacity_);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(rhs.alloc_);
+            }
+            else {
+                // Буфер rhs можно освободить только равным ему аллокатором
+                assert(alloc_ == rhs.alloc_);
+            }
+            buffer_ = rhs.buffer_;
+            capacity_ = rhs.capacity_;
 
             rhs.buffer_ = nullptr;
             rhs.capacity_ = 0;
@@ -35,13 +93,14 @@ public:
         return *this;
     }
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : alloc_(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
     ~RawMemory() {
-        Deallocate(buffer_);
+        Deallocate(buffer_, capacity_);
     }
 
     T* operator+(size_t offset) noexcept {
@@ -64,6 +123,13 @@ public:
     }
 
     void Swap(RawMemory& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(alloc_, other.alloc_);
+        }
+        else {
+            assert(alloc_ == other.alloc_);
+        }
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
@@ -80,111 +146,468 @@ public:
         return capacity_;
     }
 
+    const Alloc& GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    Alloc& GetAllocator() noexcept {
+        return alloc_;
+    }
+
+    // Меняет вместимость буфера, сохраняя его содержимое побайтово.
+    // Доступно только для тривиально перемещаемых T и аллокаторов с методом Reallocate
+    void Reallocate(size_t new_capacity) {
+        static_assert(kCanReallocate && kIsTriviallyRelocatable<T>);
+        buffer_ = alloc_.Reallocate(buffer_, capacity_, new_capacity);
+        capacity_ = new_capacity;
+    }
+
+    // Освобождает буфер и заменяет аллокатор. Нужно при propagate_on_container_copy_assignment,
+    // когда новый аллокатор не может освободить старый буфер
+    void ResetAllocator(const Alloc& alloc) noexcept {
+        Deallocate(buffer_, capacity_);
+        buffer_ = nullptr;
+        capacity_ = 0;
+        alloc_ = alloc;
+    }
+
+    // Операции над элементами выполняются через allocator_traits, чтобы аллокаторы
+    // вроде std::pmr::polymorphic_allocator могли передать себя в конструируемые объекты
+
+    template <typename... Args>
+    void Construct(T* p, Args&&... args) {
+        AllocTraits::construct(alloc_, p, std::forward<Args>(args)...);
+    }
+
+    void Destroy(T* p) noexcept {
+        AllocTraits::destroy(alloc_, p);
+    }
+
+    void DestroyN(T* p, size_t n) noexcept {
+        if constexpr (kIsStdAllocator) {
+            std::destroy_n(p, n);
+        }
+        else {
+            for (size_t i = 0; i != n; ++i) {
+                Destroy(p + i);
+            }
+        }
+    }
+
+    void UninitializedValueConstructN(T* dst, size_t n) {
+        if constexpr (kIsStdAllocator) {
+            std::uninitialized_value_construct_n(dst, n);
+        }
+        else {
+            size_t i = 0;
+            try {
+                for (; i != n; ++i) {
+                    Construct(dst + i);
+                }
+            }
+            catch (...) {
+                DestroyN(dst, i);
+                throw;
+            }
+        }
+    }
+
+    // Инициализация по умолчанию не выражается через allocator_traits::construct
+    // (он выполняет value-initialization), поэтому выполняется без участия аллокатора
+    void UninitializedDefaultConstructN(T* dst, size_t n) {
+        std::uninitialized_default_construct_n(dst, n);
+    }
+
+    // src - любой итератор ввода, элементы создаются из *src
+    template <typename InputIt>
+    void UninitializedCopyN(InputIt src, size_t n, T* dst) {
+        if constexpr (kIsStdAllocator) {
+            std::uninitialized_copy_n(src, n, dst);
+        }
+        else {
+            size_t i = 0;
+            try {
+                for (; i != n; ++i, ++src) {
+                    Construct(dst + i, *src);
+                }
+            }
+            catch (...) {
+                DestroyN(dst, i);
+                throw;
+            }
+        }
+    }
+
+    // Параллельные версии массовых операций: диапазон делится на части по policy, при исключении
+    // уже созданные во всех частях элементы разрушаются. Аллокатор вызывается из разных потоков
+    void UninitializedValueConstructN(T* dst, size_t n, const ParallelPolicy& policy) {
+        ParallelFor(n, policy, [this, dst](size_t begin, size_t end) {
+            UninitializedValueConstructN(dst + begin, end - begin);
+            }, [this, dst](size_t begin, size_t end) noexcept {
+                DestroyN(dst + begin, end - begin);
+            });
+    }
+
+    template <typename RandomIt>
+    void UninitializedCopyN(RandomIt src, size_t n, T* dst, const ParallelPolicy& policy) {
+        ParallelFor(n, policy, [this, src, dst](size_t begin, size_t end) {
+            UninitializedCopyN(src + begin, end - begin, dst + begin);
+            }, [this, dst](size_t begin, size_t end) noexcept {
+                DestroyN(dst + begin, end - begin);
+            });
+    }
+
+    void DestroyN(T* p, size_t n, const ParallelPolicy& policy) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T> || !kIsStdAllocator) {
+            ParallelFor(n, policy, [this, p](size_t begin, size_t end) noexcept {
+                DestroyN(p + begin, end - begin);
+                });
+        }
+    }
+
+    void UninitializedMoveN(T* src, size_t n, T* dst) {
+        if constexpr (kIsStdAllocator) {
+            std::uninitialized_move_n(src, n, dst);
+        }
+        else {
+            size_t i = 0;
+            try {
+                for (; i != n; ++i) {
+                    Construct(dst + i, std::move(src[i]));
+                }
+            }
+            catch (...) {
+                DestroyN(dst, i);
+                throw;
+            }
+        }
+    }
+
+    // Перемещает элементы, если перемещение не бросает исключений (или копирование невозможно),
+    // иначе копирует их, чтобы при исключении исходные элементы остались нетронутыми
+    void UninitializedMoveIfNoexceptN(T* src, size_t n, T* dst) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            UninitializedMoveN(src, n, dst);
+        }
+        else {
+            UninitializedCopyN(src, n, dst);
+        }
+    }
+
+    // Переносит n элементов из src в неинициализированную память dst и разрушает исходные.
+    // Если перенос выбросил исключение, исходные элементы остаются нетронутыми
+    void UninitializedRelocateN(T* src, size_t n, T* dst) {
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            if (n != 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(T));
+            }
+        }
+        else {
+            UninitializedMoveIfNoexceptN(src, n, dst);
+            DestroyN(src, n);
+        }
+    }
+
 private:
+    static constexpr bool kIsStdAllocator = std::is_same_v<Alloc, std::allocator<T>>;
+
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    T* Allocate(size_t n) {
+        return n != 0 ? AllocTraits::allocate(alloc_, n) : nullptr;
     }
 
     // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            AllocTraits::deallocate(alloc_, buf, n);
+        }
     }
 
+    Alloc alloc_;
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+
+// Политики роста вместимости Vector. NextCapacity возвращает новую вместимость буфера
+// не меньше required, исходя из текущей вместимости capacity
+
+struct DoublingGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        return std::max(required, capacity == 0 ? size_t(1) : capacity * 2);
+    }
+};
+
+// Рост в 1.5 раза позволяет повторно использовать освобождённые ранее блоки и экономит память
+struct OneAndHalfGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        return std::max(required, capacity == 0 ? size_t(1) : capacity + (capacity + 1) / 2);
+    }
+};
+
+struct GoldenRatioGrowth {
+    static size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        const size_t grown = capacity + static_cast<size_t>(static_cast<double>(capacity) * 0.6180339887498949);
+        return std::max(required, std::max(grown, capacity + 1));
+    }
+};
+
+// Рост на фиксированное число элементов: минимум лишней памяти ценой линейного числа реаллокаций
+template <size_t Step>
+struct FixedStepGrowth {
+    static_assert(Step > 0, "Step must be positive");
+
+    static size_t NextCapacity(size_t capacity, size_t required) noexcept {
+        return std::max(required, capacity + Step);
+    }
+};
+
+// Политика роста может также определить ShrinkCapacity(size, capacity), возвращающую желаемую
+// вместимость после уменьшения размера. Тогда Vector сам отдаёт память после удаления элементов.
+// AutoShrink уменьшает буфер вдвое больше размера, когда размер падает ниже capacity / Divisor
+template <typename Base = DoublingGrowth, size_t Divisor = 4>
+struct AutoShrink : Base {
+    static_assert(Divisor > 1, "Divisor must be greater than one");
+
+    static size_t ShrinkCapacity(size_t size, size_t capacity) noexcept {
+        return size < capacity / Divisor ? size * 2 : capacity;
+    }
+};
+
+template <typename Growth, typename = void>
+struct HasShrinkCapacity : std::false_type {
+};
+
+template <typename Growth>
+struct HasShrinkCapacity<Growth, std::void_t<decltype(Growth::ShrinkCapacity(size_t{}, size_t{}))>> : std::true_type {
+};
+
+// Аллокатор может предоставить метод size_t GoodSize(size_t n), возвращающий число элементов
+// не меньше n, которое он фактически выделит под запрос n элементов (размерный класс malloc,
+// кратность странице). Vector округляет до него вместимость, чтобы запас блока не пропадал
+template <typename Alloc, typename = void>
+struct HasGoodSize : std::false_type {
+};
+
+template <typename Alloc>
+struct HasGoodSize<Alloc, std::void_t<decltype(std::declval<const Alloc&>().GoodSize(size_t{}))>> : std::true_type {
+};
+
+// Тег конструктора Vector, создающего элементы инициализацией по умолчанию
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag kDefaultInit{};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth>
 class Vector {
 public:
+    using value_type = T;
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
 
     Vector() = default;
 
-    Vector(size_t size) : data_(size), size_(size)
+    explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc)
     {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size_);
+    }
+
+    Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        data_.UninitializedValueConstructN(data_.GetAddress(), size_);
+        RecordAllocation(size_);
+    }
+
+    // Создаёт size элементов, инициализированных по умолчанию (см. ResizeDefaultInit)
+    Vector(size_t size, DefaultInitTag, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        data_.UninitializedDefaultConstructN(data_.GetAddress(), size_);
+        RecordAllocation(size_);
+    }
+
+    // Как Vector(size), но элементы создаются в нескольких потоках согласно policy
+    Vector(size_t size, const ParallelPolicy& policy, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        data_.UninitializedValueConstructN(data_.GetAddress(), size_, policy);
+        RecordAllocation(size_);
     }
 
     Vector(const Vector& other)
-        : data_(other.size_)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+    }
+
+    Vector(const Vector& other, const Alloc& alloc)
+        : data_(other.size_, alloc)
+        , size_(other.size_)
+    {
+        data_.UninitializedCopyN(other.data_.GetAddress(), size_, data_.GetAddress());
+        RecordAllocation(size_);
+    }
+
+    // Копирование в нескольких потоках согласно policy
+    Vector(const Vector& other, const ParallelPolicy& policy)
+        : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+        data_.UninitializedCopyN(other.data_.GetAddress(), size_, data_.GetAddress(), policy);
+        RecordAllocation(size_);
     }
 
     ~Vector()
     {
-        std::destroy_n(data_.GetAddress(), size_);
+        data_.DestroyN(data_.GetAddress(), size_);
     }
 
     Vector(Vector&& other) noexcept
+        : data_(std::move(other.data_))
+        , size_(std::exchange(other.size_, 0))
     {
-        Swap(other);
+        TakeStats(other);
+    }
+
+    Vector(Vector&& other, const Alloc& alloc)
+        : data_(alloc)
+    {
+        if (AllocTraits::is_always_equal::value || data_.GetAllocator() == other.data_.GetAllocator()) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+            TakeStats(other);
+        }
+        else {
+            // Чужой буфер нельзя освободить нашим аллокатором, поэтому переносим элементы поштучно
+            RawMemory<T, Alloc> new_data(other.size_, alloc);
+            new_data.UninitializedMoveN(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+            data_.Swap(new_data);
+            size_ = other.size_;
+            RecordAllocation(size_);
+        }
     }
 
     Vector& operator=(const Vector& rhs)
     {
         if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (data_.GetAllocator() != rhs.data_.GetAllocator()) {
+                    // Текущий буфер принадлежит старому аллокатору и должен быть освобождён им же
+                    data_.DestroyN(data_.GetAddress(), size_);
+                    size_ = 0;
+                    data_.ResetAllocator(rhs.data_.GetAllocator());
+                }
+            }
             if (rhs.size_ > data_.Capacity()) {
-                Vector copy(rhs);
-                Swap(copy);
+                // Новый буфер заполняется до освобождения старого, поэтому при исключении
+                // вектор остаётся прежним
+                RawMemory<T, Alloc> new_data(rhs.size_, data_.GetAllocator());
+                new_data.UninitializedCopyN(rhs.data_.GetAddress(), rhs.size_, new_data.GetAddress());
+                data_.DestroyN(data_.GetAddress(), size_);
+                data_.Swap(new_data);
+                RecordAllocation(rhs.size_);
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>) {
+                // Разрушение таких элементов тривиально, а копирование - побайтовое
+                if (rhs.size_ != 0) {
+                    std::memcpy(static_cast<void*>(data_.GetAddress()), static_cast<const void*>(rhs.data_.GetAddress()),
+                        rhs.size_ * sizeof(T));
+                }
             }
             else {
                 if (rhs.size_ < size_)
                 {
                     std::copy(rhs.data_.GetAddress(), rhs.data_.GetAddress() + rhs.size_, data_.GetAddress());
-                    std::destroy_n(data_.GetAddress() + rhs.size_, size_ - rhs.size_);
+                    data_.DestroyN(data_.GetAddress() + rhs.size_, size_ - rhs.size_);
                 }
                 else
                 {
                     std::copy(rhs.data_.GetAddress(), rhs.data_.GetAddress() + size_, data_.GetAddress());
-                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
+                    data_.UninitializedCopyN(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
                 }
-                size_ = rhs.size_;
                 /* Скопировать элементы из rhs, создав при необходимости новые
                    или удалив существующие */
             }
+            size_ = rhs.size_;
         }
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept
+    Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+        || AllocTraits::is_always_equal::value)
     {
         if (this != &rhs) {
-            Swap(rhs);
+            if (AllocTraits::propagate_on_container_move_assignment::value
+                || AllocTraits::is_always_equal::value
+                || data_.GetAllocator() == rhs.data_.GetAllocator())
+            {
+                data_.DestroyN(data_.GetAddress(), size_);
+                data_ = std::move(rhs.data_);
+                size_ = std::exchange(rhs.size_, 0);
+                TakeStats(rhs);
+            }
+            else {
+                Vector moved(std::move(rhs), data_.GetAllocator());
+                Swap(moved);
+                TakeStats(moved);
+            }
         }
         return *this;
     }
 
     void Resize(size_t new_size)
     {
-        if (new_size < size_)
-        {
-            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
-            size_ = new_size;
-        }
-        else if (new_size == size_)
-        {
-            return;
-        }
-        else
-        {
-            if (new_size <= data_.Capacity())
-            {
-                std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
-                size_ = new_size;
-            }
-            else
-            {
-                Reserve(new_size);
-                std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
-                size_ = new_size;
-            }
-        }
+        ResizeWith(new_size, [this](T* first, size_t count) {
+            data_.UninitializedValueConstructN(first, count);
+            });
+    }
+
+    // Как Resize, но новые элементы создаются в нескольких потоках согласно policy. Страницы
+    // памяти при этом впервые касаются разные потоки, и ядро размещает каждую часть вектора
+    // на узле NUMA своего потока (first touch)
+    void Resize(size_t new_size, const ParallelPolicy& policy)
+    {
+        ResizeWith(new_size, [this, &policy](T* first, size_t count) {
+            data_.UninitializedValueConstructN(first, count, policy);
+            });
+    }
+
+    // Как Resize, но новые элементы инициализируются по умолчанию: для тривиальных типов
+    // их значение не определено и память не заполняется нулями
+    void ResizeDefaultInit(size_t new_size)
+    {
+        ResizeWith(new_size, [this](T* first, size_t count) {
+            data_.UninitializedDefaultConstructN(first, count);
+            });
+    }
 
+    // Увеличивает размер без какой-либо инициализации новых элементов. Для типов с неявным
+    // временем жизни, которые сразу заполняются целиком (например, чтением из файла или сокета)
+    void ResizeUninitialized(size_t new_size)
+    {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+            "ResizeUninitialized requires an implicit-lifetime type");
+        ResizeWith(new_size, [](T* /*first*/, size_t /*count*/) noexcept {
+            });
+    }
+
+    // Дописывает count элементов, байты которых fill(first, bytes) записывает прямо в буфер.
+    // Подходит любым тривиально копируемым типам, в том числе с инициализаторами членов:
+    // элементы получают значения из записанных байтов, как при memcpy. Если fill выбросил
+    // исключение, размер вектора не меняется
+    template <typename Fill>
+    void AppendBytes(size_t count, Fill fill)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "AppendBytes requires a trivially copyable type");
+        Reserve(size_ + count);
+        fill(data_.GetAddress() + size_, count * sizeof(T));
+        size_ += count;
     }
 
     template <typename Type>
@@ -197,27 +620,48 @@ public:
     template <typename... Args>
     T& EmplaceBack(Args&&... args)
     {
+        if constexpr (kGrowInPlace) {
+            if (size_ == Capacity()) {
+                // Реаллокация освобождает старый буфер, а args могут ссылаться на элементы вектора,
+                // поэтому новый элемент создаётся заранее и затем переносится побайтово
+                alignas(T) unsigned char new_value_buf[sizeof(T)];
+                T* new_value = reinterpret_cast<T*>(new_value_buf);
+                data_.Construct(new_value, std::forward<Args>(args)...);
+                try {
+                    data_.Reallocate(GrowCapacity(size_ + 1));
+                }
+                catch (...) {
+                    data_.Destroy(new_value);
+                    throw;
+                }
+                RecordReallocation();
+                std::memcpy(static_cast<void*>(data_ + size_), static_cast<const void*>(new_value), sizeof(T));
+                ++size_;
+                return this->Back();
+            }
+        }
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            new (new_data + size_) T(std::forward<Args>(args)...);
-
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+            RawMemory<T, Alloc> new_data(GrowCapacity(size_ + 1), data_.GetAllocator());
+            // Новый элемент создаётся до переноса старых: args могут ссылаться на элементы вектора
+            new_data.Construct(new_data + size_, std::forward<Args>(args)...);
+            try
             {
-                std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+                data_.UninitializedRelocateN(data_.GetAddress(), size_, new_data.GetAddress());
             }
-            else
+            catch (...)
             {
-                std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+                new_data.Destroy(new_data + size_);
+                throw;
             }
 
-            std::destroy_n(data_.GetAddress(), size_);
             data_.Swap(new_data);
+            RecordReallocation();
             ++size_;
             return this->Back();
         }
         else
         {
-            new (data_ + size_) T(std::forward<Args>(args)...);
+            data_.Construct(data_ + size_, std::forward<Args>(args)...);
             ++size_;
             return this->Back();
         }
@@ -233,67 +677,89 @@ public:
             EmplaceBack(std::forward<Args>(args)...);
             return std::prev(end());
         }
-        else if (size_ == data_.Capacity())
+        else if (size_ == data_.Capacity() && !kGrowInPlace)
         {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            auto new_elem_it = new (new_data + shift) T(std::forward<Args>(args)...);
+            RawMemory<T, Alloc> new_data(GrowCapacity(size_ + 1), data_.GetAllocator());
+            T* new_elem_it = new_data + shift;
+            new_data.Construct(new_elem_it, std::forward<Args>(args)...);
 
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+            if constexpr (kIsTriviallyRelocatable<T>)
             {
-                try
-                {
-                    std::uninitialized_move_n(begin(), shift, new_data.GetAddress());
-                }
-                catch (...)
-                {
-                    std::destroy_at(new_elem_it);
-                }
-                try
-                {
-                    std::uninitialized_move_n(begin() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
-                }
-                catch (...)
-                {
-                    std::destroy(begin(), begin() + shift + 1);
-                }
+                data_.UninitializedRelocateN(begin(), shift, new_data.GetAddress());
+                data_.UninitializedRelocateN(begin() + shift, size_ - shift, new_elem_it + 1);
+                data_.Swap(new_data);
+                RecordReallocation();
+                ++size_;
+                return new_elem_it;
             }
-            else
+
+            try
             {
-                try
-                {
-                    std::uninitialized_copy_n(begin(), shift, new_data.GetAddress());
-                }
-                catch (...)
-                {
-                    std::destroy_at(new_elem_it);
-                }
-                try
-                {
-                    std::uninitialized_copy_n(begin() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
-                }
-                catch (...)
-                {
-                    std::destroy(begin(), begin() + shift + 1);
-                }
+                new_data.UninitializedMoveIfNoexceptN(begin(), shift, new_data.GetAddress());
+            }
+            catch (...)
+            {
+                new_data.Destroy(new_elem_it);
+                throw;
+            }
+            try
+            {
+                new_data.UninitializedMoveIfNoexceptN(begin() + shift, size_ - shift, new_elem_it + 1);
+            }
+            catch (...)
+            {
+                new_data.DestroyN(new_data.GetAddress(), shift + 1);
+                throw;
             }
 
-            std::destroy(begin(), end());
+            data_.DestroyN(begin(), size_);
             data_.Swap(new_data);
+            RecordReallocation();
             ++size_;
             return new_elem_it;
         }
         else
         {
-            auto new_value = T(std::forward<Args>(args)...);
-            new (data_ + size_) T(std::move(*(std::prev(end()))));
+            // Временное значение создаётся через аллокатор, так как args могут ссылаться на элементы вектора
+            alignas(T) unsigned char new_value_buf[sizeof(T)];
+            T* new_value = reinterpret_cast<T*>(new_value_buf);
+            data_.Construct(new_value, std::forward<Args>(args)...);
+            if constexpr (kIsTriviallyRelocatable<T>) {
+                if constexpr (kGrowInPlace) {
+                    if (size_ == data_.Capacity()) {
+                        try {
+                            data_.Reallocate(GrowCapacity(size_ + 1));
+                        }
+                        catch (...) {
+                            data_.Destroy(new_value);
+                            throw;
+                        }
+                        RecordReallocation();
+                    }
+                }
+                std::memmove(static_cast<void*>(begin() + shift + 1), static_cast<const void*>(begin() + shift),
+                    (size_ - shift) * sizeof(T));
+                std::memcpy(static_cast<void*>(begin() + shift), static_cast<const void*>(new_value), sizeof(T));
+                ++size_;
+                return begin() + shift;
+            }
+            try {
+                data_.Construct(end(), std::move(*(std::prev(end()))));
+            }
+            catch (...) {
+                data_.Destroy(new_value);
+                throw;
+            }
             try {
                 std::move_backward(iterator(pos), std::prev(end()), end());
+                *(iterator(pos)) = std::move(*new_value);
             }
             catch (...) {
-                std::destroy_n(end(), 1);
+                data_.Destroy(end());
+                data_.Destroy(new_value);
                 throw;
             }
-            *(iterator(pos)) = std::move(new_value);
+            data_.Destroy(new_value);
             ++size_;
             return iterator(pos);
         }
@@ -301,20 +767,125 @@ public:
     iterator Erase(const_iterator pos) /*noexcept(std::is_nothrow_move_assignable_v<T>)*/
     {
         assert(pos >= begin() && pos < end());
-        size_t shift = iterator(pos) - begin();
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+        return Erase(pos, pos + 1);
+    }
+
+    // Удаляет элементы [first, last), сдвигая хвост один раз
+    iterator Erase(const_iterator first, const_iterator last)
+    {
+        assert(first >= begin() && first <= last && last <= end());
+        const size_t shift = first - cbegin();
+        const size_t count = last - first;
+        iterator position = begin() + shift;
+        if (count == 0)
+        {
+            return position;
+        }
+        if constexpr (kIsTriviallyRelocatable<T>)
         {
-            std::move(iterator(pos) + 1, end(), iterator(pos));
+            data_.DestroyN(position, count);
+            std::memmove(static_cast<void*>(position), static_cast<const void*>(position + count),
+                (size_ - shift - count) * sizeof(T));
         }
         else
         {
-            std::copy(iterator(pos) + 1, end(), iterator(pos));
+            iterator new_end;
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+            {
+                new_end = std::move(position + count, end(), position);
+            }
+            else
+            {
+                new_end = std::copy(position + count, end(), position);
+            }
+            data_.DestroyN(new_end, count);
         }
-        std::destroy_at(std::prev(end()));
-        --size_;
+        size_ -= count;
+        MaybeShrink();
         return begin() + shift;
     }
 
+    // Удаляет все элементы, для которых pred возвращает true, за один проход с сохранением
+    // порядка остальных. Возвращает число удалённых элементов
+    template <typename Predicate>
+    size_t EraseIf(Predicate pred)
+    {
+        iterator it = std::find_if(begin(), end(), pred);
+        if (it == end())
+        {
+            return 0;
+        }
+        const size_t old_size = size_;
+        iterator dst = it;
+        if constexpr (kIsTriviallyRelocatable<T>)
+        {
+            data_.Destroy(it++);
+            try
+            {
+                for (; it != end(); ++it)
+                {
+                    if (pred(*it))
+                    {
+                        data_.Destroy(it);
+                    }
+                    else
+                    {
+                        std::memcpy(static_cast<void*>(dst++), static_cast<const void*>(it), sizeof(T));
+                    }
+                }
+            }
+            catch (...)
+            {
+                // Необработанные элементы сдвигаются, закрывая промежуток после уже удалённых
+                const size_t rest = end() - it;
+                std::memmove(static_cast<void*>(dst), static_cast<const void*>(it), rest * sizeof(T));
+                size_ = (dst - begin()) + rest;
+                throw;
+            }
+            size_ = dst - begin();
+        }
+        else
+        {
+            for (++it; it != end(); ++it)
+            {
+                if (!pred(*it))
+                {
+                    *dst++ = std::move(*it);
+                }
+            }
+            data_.DestroyN(dst, end() - dst);
+            size_ = dst - begin();
+        }
+        const size_t erased = old_size - size_;
+        MaybeShrink();
+        return erased;
+    }
+
+    // Удаляет элемент за O(1), перенося на его место последний. Порядок элементов не сохраняется
+    iterator UnorderedErase(const_iterator pos)
+    {
+        assert(pos >= begin() && pos < end());
+        const size_t shift = pos - cbegin();
+        iterator position = begin() + shift;
+        iterator last = std::prev(end());
+        if (position != last)
+        {
+            if constexpr (kIsTriviallyRelocatable<T>)
+            {
+                data_.Destroy(position);
+                std::memcpy(static_cast<void*>(position), static_cast<const void*>(last), sizeof(T));
+                --size_;
+                MaybeShrink();
+                return begin() + shift;
+            }
+            else
+            {
+                *position = std::move(*last);
+            }
+        }
+        PopBack();
+        return begin() + shift;
+    }
 
     iterator Insert(const_iterator pos, const T& value)
     {
@@ -325,6 +896,62 @@ public:
         return this->Emplace(pos, std::move(value));
     }
 
+    // Вставка диапазона выполняет не более одной реаллокации и сдвигает хвост один раз
+    template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            return InsertRange(pos, first, static_cast<size_t>(std::distance(first, last)));
+        }
+        else {
+            // Длину однопроходного диапазона не узнать заранее, поэтому сначала собираем его целиком
+            const size_t shift = pos - cbegin();
+            Vector values(data_.GetAllocator());
+            for (; first != last; ++first) {
+                values.EmplaceBack(*first);
+            }
+            return InsertRange(begin() + shift, std::make_move_iterator(values.begin()), values.Size());
+        }
+    }
+
+    iterator Insert(const_iterator pos, size_t count, const T& value)
+    {
+        if (count == 0) {
+            return begin() + (pos - cbegin());
+        }
+        // value может ссылаться на элемент вектора, который сдвинется при вставке
+        alignas(T) unsigned char value_copy_buf[sizeof(T)];
+        T* value_copy = reinterpret_cast<T*>(value_copy_buf);
+        data_.Construct(value_copy, value);
+        try {
+            iterator result = InsertRange(pos, RepeatIterator(*value_copy), count);
+            data_.Destroy(value_copy);
+            return result;
+        }
+        catch (...) {
+            data_.Destroy(value_copy);
+            throw;
+        }
+    }
+
+    iterator Insert(const_iterator pos, std::initializer_list<T> values)
+    {
+        return InsertRange(pos, values.begin(), values.size());
+    }
+
+    // Добавляет в конец элементы диапазона; элементы временного диапазона перемещаются
+    template <typename Range>
+    void Append(Range&& range)
+    {
+        if constexpr (std::is_lvalue_reference_v<Range>) {
+            Insert(cend(), std::begin(range), std::end(range));
+        }
+        else {
+            Insert(cend(), std::make_move_iterator(std::begin(range)), std::make_move_iterator(std::end(range)));
+        }
+    }
+
     T& Back()
     {
         return data_[size_ - 1];
@@ -333,25 +960,53 @@ public:
     void PopBack()
     {
         assert(size_ > 0);
-        std::destroy_at(data_.GetAddress() + size_ - 1);
+        data_.Destroy(data_.GetAddress() + size_ - 1);
         --size_;
+        MaybeShrink();
     }
 
-    void Reserve(size_t new_capacity)
+    // Удаляет все элементы, сохраняя вместимость
+    void Clear() noexcept
     {
-        if (new_capacity <= data_.Capacity()) {
+        data_.DestroyN(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    // Разрушает элементы в нескольких потоках. Деструктор параметров не принимает, поэтому
+    // большой вектор нетривиальных элементов стоит очистить так перед уничтожением
+    void Clear(const ParallelPolicy& policy) noexcept
+    {
+        data_.DestroyN(data_.GetAddress(), size_, policy);
+        size_ = 0;
+    }
+
+    // Удаляет все элементы и освобождает буфер
+    void ClearAndRelease() noexcept
+    {
+        Clear();
+        RawMemory<T, Alloc> empty(data_.GetAllocator());
+        data_.Swap(empty);
+    }
+
+    // Уменьшает вместимость до размера (с точностью до GoodSize аллокатора)
+    void ShrinkToFit()
+    {
+        if (size_ == 0) {
+            ClearAndRelease();
             return;
         }
-        RawMemory<T> new_data(new_capacity);
-
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+        const size_t new_capacity = RoundUpCapacity(size_);
+        if (new_capacity < data_.Capacity()) {
+            ChangeCapacity(new_capacity);
         }
-        else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+    }
+
+    void Reserve(size_t new_capacity)
+    {
+        if (new_capacity <= data_.Capacity()) {
+            return;
         }
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+        ChangeCapacity(RoundUpCapacity(new_capacity));
     }
 
     size_t Size() const noexcept {
@@ -362,6 +1017,20 @@ public:
         return data_.Capacity();
     }
 
+    Alloc GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    // Статистика работы с памятью. Без VECTOR_ENABLE_STATS счётчики не ведутся и всегда нулевые
+    const VectorStats& Stats() const noexcept {
+#ifdef VECTOR_ENABLE_STATS
+        return stats_.stats;
+#else
+        static const VectorStats empty;
+        return empty;
+#endif
+    }
+
     const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
@@ -371,6 +1040,7 @@ public:
         return data_[index];
     }
 
+    // Статистика остаётся у своего экземпляра
     void Swap(Vector& other) noexcept
     {
         data_.Swap(other.data_);
@@ -403,10 +1073,252 @@ public:
     }
 
 private:
-    RawMemory<T> data_;
-    size_t size_ = 0;
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    // Итератор, count раз возвращающий одно и то же значение
+    class RepeatIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        explicit RepeatIterator(const T& value, size_t index = 0) noexcept
+            : value_(&value)
+            , index_(index)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return *value_;
+        }
+        pointer operator->() const noexcept {
+            return value_;
+        }
+        RepeatIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        RepeatIterator operator++(int) noexcept {
+            RepeatIterator old = *this;
+            ++index_;
+            return old;
+        }
+        bool operator==(const RepeatIterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const RepeatIterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        const T* value_;
+        size_t index_;
+    };
+
+    // Вставляет count элементов, созданных из [first, first + count), перед pos.
+    // Диапазон не должен ссылаться на элементы вектора
+    template <typename ForwardIt>
+    iterator InsertRange(const_iterator pos, ForwardIt first, size_t count)
+    {
+        assert(pos >= begin() && pos <= end());
+        const size_t shift = pos - cbegin();
+        if (count == 0) {
+            return begin() + shift;
+        }
+
+        if (size_ + count > data_.Capacity()) {
+            RawMemory<T, Alloc> new_data(GrowCapacity(size_ + count), data_.GetAllocator());
+            T* new_first = new_data + shift;
+            new_data.UninitializedCopyN(first, count, new_first);
+            if constexpr (kIsTriviallyRelocatable<T>) {
+                data_.UninitializedRelocateN(begin(), shift, new_data.GetAddress());
+                data_.UninitializedRelocateN(begin() + shift, size_ - shift, new_first + count);
+            }
+            else {
+                try {
+                    new_data.UninitializedMoveIfNoexceptN(begin(), shift, new_data.GetAddress());
+                }
+                catch (...) {
+                    new_data.DestroyN(new_first, count);
+                    throw;
+                }
+                try {
+                    new_data.UninitializedMoveIfNoexceptN(begin() + shift, size_ - shift, new_first + count);
+                }
+                catch (...) {
+                    new_data.DestroyN(new_data.GetAddress(), shift + count);
+                    throw;
+                }
+                data_.DestroyN(begin(), size_);
+            }
+            data_.Swap(new_data);
+            RecordReallocation();
+            size_ += count;
+            return new_first;
+        }
 
-    static void CopyConstruct(T* buf, const T& elem) {
-        new (buf) T(elem);
+        T* position = begin() + shift;
+        const size_t tail = size_ - shift;
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            // Хвост сдвигается побайтово, а при исключении возвращается на место
+            std::memmove(static_cast<void*>(position + count), static_cast<const void*>(position), tail * sizeof(T));
+            try {
+                data_.UninitializedCopyN(first, count, position);
+            }
+            catch (...) {
+                std::memmove(static_cast<void*>(position), static_cast<const void*>(position + count), tail * sizeof(T));
+                throw;
+            }
+            size_ += count;
+        }
+        else if (tail > count) {
+            T* old_end = end();
+            data_.UninitializedMoveN(old_end - count, count, old_end);
+            size_ += count;
+            std::move_backward(position, old_end - count, old_end);
+            std::copy_n(first, count, position);
+        }
+        else {
+            T* old_end = end();
+            ForwardIt mid = std::next(first, tail);
+            data_.UninitializedCopyN(mid, count - tail, old_end);
+            try {
+                data_.UninitializedMoveN(position, tail, position + count);
+            }
+            catch (...) {
+                data_.DestroyN(old_end, count - tail);
+                throw;
+            }
+            size_ += count;
+            std::copy_n(first, tail, position);
+        }
+        return position;
     }
-};
\ No newline at end of file
+
+    // Переносит элементы в буфер вместимостью new_capacity >= size_
+    void ChangeCapacity(size_t new_capacity)
+    {
+        if constexpr (kGrowInPlace) {
+            data_.Reallocate(new_capacity);
+        }
+        else {
+            RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+            data_.UninitializedRelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+            data_.Swap(new_data);
+        }
+        RecordReallocation();
+    }
+
+    // Отдаёт лишнюю память, если этого требует политика роста. Уменьшение буфера не обязательно,
+    // поэтому ошибка при переносе элементов лишь оставляет прежний буфер
+    void MaybeShrink() noexcept
+    {
+        if constexpr (HasShrinkCapacity<Growth>::value) {
+            const size_t new_capacity = Growth::ShrinkCapacity(size_, data_.Capacity());
+            if (new_capacity >= data_.Capacity()) {
+                return;
+            }
+            try {
+                if (new_capacity == 0) {
+                    ClearAndRelease();
+                    return;
+                }
+                // После округления до GoodSize буфер может не уменьшиться вовсе
+                const size_t rounded_capacity = RoundUpCapacity(std::max(new_capacity, size_));
+                if (rounded_capacity < data_.Capacity()) {
+                    ChangeCapacity(rounded_capacity);
+                }
+            }
+            catch (...) {
+            }
+        }
+    }
+
+    // Изменяет размер вектора, создавая недостающие элементы функцией construct(first, count)
+    template <typename Construct>
+    void ResizeWith(size_t new_size, Construct construct)
+    {
+        if (new_size < size_)
+        {
+            data_.DestroyN(data_.GetAddress() + new_size, size_ - new_size);
+        }
+        else if (new_size > size_)
+        {
+            Reserve(new_size);
+            construct(data_.GetAddress() + size_, new_size - size_);
+        }
+        size_ = new_size;
+        MaybeShrink();
+    }
+
+    // Вместимость для роста до required элементов согласно политике роста
+    size_t GrowCapacity(size_t required) const
+    {
+        return RoundUpCapacity(Growth::NextCapacity(data_.Capacity(), required));
+    }
+
+    size_t RoundUpCapacity(size_t capacity) const
+    {
+        if constexpr (HasGoodSize<Alloc>::value) {
+            return data_.GetAllocator().GoodSize(capacity);
+        }
+        else {
+            return capacity;
+        }
+    }
+
+    // Учитывает выделение буфера под capacity элементов
+    void RecordAllocation([[maybe_unused]] size_t capacity) noexcept
+    {
+#ifdef VECTOR_ENABLE_STATS
+        if (capacity == 0) {
+            return;
+        }
+        VectorStats& stats = stats_.stats;
+        ++stats.allocations;
+        stats.bytes_allocated += capacity * sizeof(T);
+        stats.peak_capacity = std::max(stats.peak_capacity, capacity);
+#endif
+    }
+
+    // Учитывает новый буфер, который уже стал текущим, и перенос в него size_ элементов
+    void RecordReallocation() noexcept
+    {
+#ifdef VECTOR_ENABLE_STATS
+        RecordAllocation(data_.Capacity());
+        if (size_ == 0) {
+            return;
+        }
+        VectorStats& stats = stats_.stats;
+        ++stats.reallocations;
+        if constexpr (kRelocatesByMove) {
+            stats.elements_moved += size_;
+        }
+        else {
+            stats.elements_copied += size_;
+        }
+#endif
+    }
+
+    // Забирает статистику вектора, чей буфер достался этому
+    void TakeStats([[maybe_unused]] Vector& other) noexcept
+    {
+#ifdef VECTOR_ENABLE_STATS
+        stats_.TakeFrom(other.stats_);
+#endif
+    }
+
+    // Буфер растёт через Reallocate аллокатора (realloc/mremap), без отдельного переноса элементов
+    static constexpr bool kGrowInPlace = kIsTriviallyRelocatable<T> && RawMemory<T, Alloc>::kCanReallocate;
+    // При реаллокации элементы переносятся перемещением или побайтово, а не копированием
+    static constexpr bool kRelocatesByMove = kIsTriviallyRelocatable<T>
+        || std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+
+    RawMemory<T, Alloc> data_;
+    size_t size_ = 0;
+#ifdef VECTOR_ENABLE_STATS
+    RegisteredVectorStats stats_{typeid(T).name(), sizeof(T)};
+#endif
+};
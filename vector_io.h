@@ -0,0 +1,241 @@
+#pragma once
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "vector.h"
+
+// Двоичный формат вектора тривиально копируемых элементов: заголовок и следом буфер вектора
+// как есть. Числа хранятся в порядке байтов машины, чужой порядок распознаётся по magic
+struct VectorFileHeader {
+    static constexpr uint32_t kMagic = 0x56454354; // "VECT"
+    static constexpr uint32_t kVersion = 1;
+
+    uint32_t magic = kMagic;
+    uint32_t version = kVersion;
+    uint32_t element_size = 0;
+    uint32_t element_alignment = 0;
+    uint64_t count = 0;
+    // VectorChecksum от байтов элементов
+    uint64_t checksum = 0;
+};
+
+static_assert(sizeof(VectorFileHeader) == 32 && std::is_trivially_copyable_v<VectorFileHeader>);
+
+// Быстрая некриптографическая контрольная сумма: обрабатывает данные словами по 8 байт
+inline uint64_t VectorChecksum(const void* data, size_t bytes) noexcept
+{
+    constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+    constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    uint64_t hash = kPrime2 ^ bytes;
+    for (; bytes >= 8; bytes -= 8, p += 8) {
+        uint64_t word;
+        std::memcpy(&word, p, 8);
+        hash ^= word * kPrime1;
+        hash = ((hash << 31) | (hash >> 33)) * kPrime2;
+    }
+    uint64_t tail = 0;
+    if (bytes != 0) {
+        std::memcpy(&tail, p, bytes);
+    }
+    hash ^= tail * kPrime1;
+    hash ^= hash >> 29;
+    hash *= kPrime2;
+    return hash ^ (hash >> 32);
+}
+
+namespace vector_io_detail {
+
+    template <typename T>
+    VectorFileHeader MakeHeader(const T* data, size_t count) noexcept
+    {
+        VectorFileHeader header;
+        header.element_size = sizeof(T);
+        header.element_alignment = alignof(T);
+        header.count = count;
+        header.checksum = VectorChecksum(data, count * sizeof(T));
+        return header;
+    }
+
+    // Проверяет заголовок и возвращает размер данных в байтах
+    template <typename T>
+    size_t CheckHeader(const VectorFileHeader& header)
+    {
+        if (header.magic != VectorFileHeader::kMagic) {
+            throw std::runtime_error("Vector data: bad magic (not a vector file or foreign byte order)");
+        }
+        if (header.version != VectorFileHeader::kVersion) {
+            throw std::runtime_error("Vector data: unsupported version " + std::to_string(header.version));
+        }
+        if (header.element_size != sizeof(T) || header.element_alignment != alignof(T)) {
+            throw std::runtime_error("Vector data: element layout does not match");
+        }
+        if (header.count > size_t(-1) / sizeof(T)) {
+            throw std::runtime_error("Vector data: element count is too large");
+        }
+        return static_cast<size_t>(header.count) * sizeof(T);
+    }
+
+    template <typename T, typename Alloc, typename Growth>
+    void CheckPayload(Vector<T, Alloc, Growth>& v, const VectorFileHeader& header)
+    {
+        if (VectorChecksum(v.begin(), v.Size() * sizeof(T)) != header.checksum) {
+            v.Clear();
+            throw std::runtime_error("Vector data: checksum mismatch");
+        }
+    }
+
+    inline void ReadExactly(int fd, void* data, size_t bytes)
+    {
+        char* p = static_cast<char*>(data);
+        while (bytes != 0) {
+            const ssize_t result = read(fd, p, bytes);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "read");
+            }
+            if (result == 0) {
+                throw std::runtime_error("Vector data: unexpected end of file");
+            }
+            p += result;
+            bytes -= static_cast<size_t>(result);
+        }
+    }
+
+    // Сколько байт читается в буфер, размер которого ещё не подтверждён источником. Иначе
+    // испорченный count в заголовке заставил бы выделить память под несуществующие данные
+    inline constexpr size_t kMaxUnverifiedBytes = size_t(16) << 20;
+
+    // Читает count элементов функцией read(data, bytes), увеличивая буфер не более чем вдвое
+    // относительно уже прочитанного. verified_count элементов можно выделить сразу
+    template <typename T, typename Alloc, typename Growth, typename Read>
+    void ReadElements(Vector<T, Alloc, Growth>& v, size_t count, size_t verified_count, Read read)
+    {
+        v.Clear();
+        try {
+            size_t loaded = 0;
+            while (loaded < count) {
+                const size_t chunk = std::max({ verified_count, loaded, kMaxUnverifiedBytes / sizeof(T), size_t(1) });
+                const size_t step = std::min(count - loaded, chunk);
+                v.AppendBytes(step, read);
+                loaded += step;
+            }
+        }
+        catch (...) {
+            v.Clear();
+            throw;
+        }
+    }
+
+    // Число байт до конца обычного файла или size_t(-1), если источник - не обычный файл
+    inline size_t RemainingBytes(int fd) noexcept
+    {
+        struct stat info;
+        if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+            return size_t(-1);
+        }
+        const off_t position = lseek(fd, 0, SEEK_CUR);
+        if (position < 0) {
+            return size_t(-1);
+        }
+        return info.st_size > position ? static_cast<size_t>(info.st_size - position) : 0;
+    }
+
+} // namespace vector_io_detail
+
+// Записывает вектор в файловый дескриптор одним вызовом writev (повторяя его только
+// при частичной записи)
+template <typename T, typename Alloc, typename Growth>
+void WriteTo(int fd, const Vector<T, Alloc, Growth>& v)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be written as bytes");
+    const VectorFileHeader header = vector_io_detail::MakeHeader(v.begin(), v.Size());
+    iovec parts[2] = {
+        { const_cast<VectorFileHeader*>(&header), sizeof(header) },
+        { const_cast<T*>(v.begin()), v.Size() * sizeof(T) },
+    };
+    iovec* part = parts;
+    int part_count = v.Size() != 0 ? 2 : 1;
+    while (part_count != 0) {
+        const ssize_t result = writev(fd, part, part_count);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "writev");
+        }
+        // Пропускаем записанное
+        size_t written = static_cast<size_t>(result);
+        while (part_count != 0 && written >= part->iov_len) {
+            written -= part->iov_len;
+            ++part;
+            --part_count;
+        }
+        if (part_count != 0) {
+            part->iov_base = static_cast<char*>(part->iov_base) + written;
+            part->iov_len -= written;
+        }
+    }
+}
+
+template <typename T, typename Alloc, typename Growth>
+void WriteTo(std::ostream& out, const Vector<T, Alloc, Growth>& v)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be written as bytes");
+    const VectorFileHeader header = vector_io_detail::MakeHeader(v.begin(), v.Size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(v.begin()), static_cast<std::streamsize>(v.Size() * sizeof(T)));
+}
+
+// Читает вектор, записанный WriteTo, заменяя содержимое v. Данные читаются прямо в буфер
+// вектора без создания элементов. Размер обычного файла сверяется с заголовком заранее, из
+// каналов и потоков буфер растёт по мере поступления данных. При ошибке формата или
+// ввода-вывода выбрасывает исключение
+template <typename T, typename Alloc, typename Growth>
+void ReadFrom(int fd, Vector<T, Alloc, Growth>& v)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be read as bytes");
+    VectorFileHeader header;
+    vector_io_detail::ReadExactly(fd, &header, sizeof(header));
+    const size_t bytes = vector_io_detail::CheckHeader<T>(header);
+    const size_t remaining = vector_io_detail::RemainingBytes(fd);
+    if (remaining != size_t(-1) && bytes > remaining) {
+        throw std::runtime_error("Vector data: file is shorter than the element count");
+    }
+    const size_t count = static_cast<size_t>(header.count);
+    vector_io_detail::ReadElements(v, count, remaining != size_t(-1) ? count : 0, [fd](T* data, size_t size) {
+        vector_io_detail::ReadExactly(fd, data, size);
+        });
+    vector_io_detail::CheckPayload(v, header);
+}
+
+template <typename T, typename Alloc, typename Growth>
+void ReadFrom(std::istream& in, Vector<T, Alloc, Growth>& v)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be read as bytes");
+    VectorFileHeader header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        throw std::runtime_error("Vector data: cannot read header");
+    }
+    vector_io_detail::CheckHeader<T>(header);
+    vector_io_detail::ReadElements(v, static_cast<size_t>(header.count), 0, [&in](T* data, size_t size) {
+        if (!in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("Vector data: unexpected end of stream");
+        }
+        });
+    vector_io_detail::CheckPayload(v, header);
+}
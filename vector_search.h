@@ -0,0 +1,586 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SEARCH_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "vector.h"
+
+// Набор векторных инструкций, которым выполняется поиск
+enum class SimdLevel {
+    kScalar,
+    kSse42,
+    kAvx2,
+    kAvx512,
+};
+
+// Лучший набор инструкций, поддерживаемый процессором и ОС. Определяется один раз
+inline SimdLevel DetectSimdLevel() noexcept
+{
+#ifdef VECTOR_SEARCH_X86_KERNELS
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::kAvx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::kAvx2;
+        }
+        if (__builtin_cpu_supports("sse4.2")) {
+            return SimdLevel::kSse42;
+        }
+        return SimdLevel::kScalar;
+    }();
+    return level;
+#else
+    return SimdLevel::kScalar;
+#endif
+}
+
+namespace vector_search_detail {
+
+    inline std::atomic<SimdLevel>& ActiveLevel() noexcept
+    {
+        static std::atomic<SimdLevel> level{ DetectSimdLevel() };
+        return level;
+    }
+
+    template <typename T>
+    constexpr bool kHasKernels = std::is_same_v<T, int32_t> || std::is_same_v<T, float>;
+
+    template <typename T>
+    size_t IndexOfScalar(const T* data, size_t size, const T& value)
+    {
+        return std::find(data, data + size, value) - data;
+    }
+
+    template <typename T>
+    size_t CountScalar(const T* data, size_t size, const T& value)
+    {
+        return static_cast<size_t>(std::count(data, data + size, value));
+    }
+
+    template <typename T>
+    std::pair<T, T> MinMaxScalar(const T* data, size_t size)
+    {
+        const auto [min, max] = std::minmax_element(data, data + size);
+        return { *min, *max };
+    }
+
+#ifdef VECTOR_SEARCH_X86_KERNELS
+
+    // Ядра обрабатывают по регистру за итерацию, остаток - скалярно (AVX-512 - маской).
+    // MinMax ведёт две пары накопителей, чтобы задержка min/max не ограничивала скорость;
+    // накопители заполняются первым элементом, поэтому он не влияет на результат
+
+    // SSE4.2: регистры по 4 элемента
+
+    __attribute__((target("sse4.2"))) inline size_t IndexOfSse42(const int32_t* data, size_t size, int32_t value)
+    {
+        const __m128i needle = _mm_set1_epi32(value);
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+            const int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + IndexOfScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("sse4.2"))) inline size_t IndexOfSse42(const float* data, size_t size, float value)
+    {
+        const __m128 needle = _mm_set1_ps(value);
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + IndexOfScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("sse4.2"))) inline size_t CountSse42(const int32_t* data, size_t size, int32_t value)
+    {
+        const __m128i needle = _mm_set1_epi32(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            const __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle);
+            count += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(eq)));
+        }
+        return count + CountScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("sse4.2"))) inline size_t CountSse42(const float* data, size_t size, float value)
+    {
+        const __m128 needle = _mm_set1_ps(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4) {
+            count += __builtin_popcount(_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(data + i), needle)));
+        }
+        return count + CountScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("sse4.2"))) inline std::pair<int32_t, int32_t> MinMaxSse42(const int32_t* data, size_t size)
+    {
+        __m128i min0 = _mm_set1_epi32(data[0]);
+        __m128i max0 = min0;
+        __m128i min1 = min0;
+        __m128i max1 = min0;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 4));
+            min0 = _mm_min_epi32(min0, x0);
+            max0 = _mm_max_epi32(max0, x0);
+            min1 = _mm_min_epi32(min1, x1);
+            max1 = _mm_max_epi32(max1, x1);
+        }
+        if (i + 4 <= size) {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            min0 = _mm_min_epi32(min0, x);
+            max0 = _mm_max_epi32(max0, x);
+            i += 4;
+        }
+        min0 = _mm_min_epi32(min0, min1);
+        max0 = _mm_max_epi32(max0, max1);
+        alignas(16) int32_t mins[4];
+        alignas(16) int32_t maxs[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(mins), min0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(maxs), max0);
+        std::pair<int32_t, int32_t> result{ *std::min_element(mins, mins + 4), *std::max_element(maxs, maxs + 4) };
+        for (; i < size; ++i) {
+            result.first = std::min(result.first, data[i]);
+            result.second = std::max(result.second, data[i]);
+        }
+        return result;
+    }
+
+    __attribute__((target("sse4.2"))) inline std::pair<float, float> MinMaxSse42(const float* data, size_t size)
+    {
+        __m128 min0 = _mm_set1_ps(data[0]);
+        __m128 max0 = min0;
+        __m128 min1 = min0;
+        __m128 max1 = min0;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m128 x0 = _mm_loadu_ps(data + i);
+            const __m128 x1 = _mm_loadu_ps(data + i + 4);
+            min0 = _mm_min_ps(min0, x0);
+            max0 = _mm_max_ps(max0, x0);
+            min1 = _mm_min_ps(min1, x1);
+            max1 = _mm_max_ps(max1, x1);
+        }
+        if (i + 4 <= size) {
+            const __m128 x = _mm_loadu_ps(data + i);
+            min0 = _mm_min_ps(min0, x);
+            max0 = _mm_max_ps(max0, x);
+            i += 4;
+        }
+        min0 = _mm_min_ps(min0, min1);
+        max0 = _mm_max_ps(max0, max1);
+        alignas(16) float mins[4];
+        alignas(16) float maxs[4];
+        _mm_store_ps(mins, min0);
+        _mm_store_ps(maxs, max0);
+        std::pair<float, float> result{ *std::min_element(mins, mins + 4), *std::max_element(maxs, maxs + 4) };
+        for (; i < size; ++i) {
+            result.first = std::min(result.first, data[i]);
+            result.second = std::max(result.second, data[i]);
+        }
+        return result;
+    }
+
+    // AVX2: регистры по 8 элементов
+
+    __attribute__((target("avx2"))) inline size_t IndexOfAvx2(const int32_t* data, size_t size, int32_t value)
+    {
+        const __m256i needle = _mm256_set1_epi32(value);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+            const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + IndexOfScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("avx2"))) inline size_t IndexOfAvx2(const float* data, size_t size, float value)
+    {
+        const __m256 needle = _mm256_set1_ps(value);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        return i + IndexOfScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("avx2"))) inline size_t CountAvx2(const int32_t* data, size_t size, int32_t value)
+    {
+        const __m256i needle = _mm256_set1_epi32(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            const __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+            count += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(eq)));
+        }
+        return count + CountScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("avx2"))) inline size_t CountAvx2(const float* data, size_t size, float value)
+    {
+        const __m256 needle = _mm256_set1_ps(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            count += __builtin_popcount(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ)));
+        }
+        return count + CountScalar(data + i, size - i, value);
+    }
+
+    __attribute__((target("avx2"))) inline std::pair<int32_t, int32_t> MinMaxAvx2(const int32_t* data, size_t size)
+    {
+        __m256i min0 = _mm256_set1_epi32(data[0]);
+        __m256i max0 = min0;
+        __m256i min1 = min0;
+        __m256i max1 = min0;
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            const __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 8));
+            min0 = _mm256_min_epi32(min0, x0);
+            max0 = _mm256_max_epi32(max0, x0);
+            min1 = _mm256_min_epi32(min1, x1);
+            max1 = _mm256_max_epi32(max1, x1);
+        }
+        if (i + 8 <= size) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            min0 = _mm256_min_epi32(min0, x);
+            max0 = _mm256_max_epi32(max0, x);
+            i += 8;
+        }
+        min0 = _mm256_min_epi32(min0, min1);
+        max0 = _mm256_max_epi32(max0, max1);
+        alignas(32) int32_t mins[8];
+        alignas(32) int32_t maxs[8];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(mins), min0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), max0);
+        std::pair<int32_t, int32_t> result{ *std::min_element(mins, mins + 8), *std::max_element(maxs, maxs + 8) };
+        for (; i < size; ++i) {
+            result.first = std::min(result.first, data[i]);
+            result.second = std::max(result.second, data[i]);
+        }
+        return result;
+    }
+
+    __attribute__((target("avx2"))) inline std::pair<float, float> MinMaxAvx2(const float* data, size_t size)
+    {
+        __m256 min0 = _mm256_set1_ps(data[0]);
+        __m256 max0 = min0;
+        __m256 min1 = min0;
+        __m256 max1 = min0;
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            const __m256 x0 = _mm256_loadu_ps(data + i);
+            const __m256 x1 = _mm256_loadu_ps(data + i + 8);
+            min0 = _mm256_min_ps(min0, x0);
+            max0 = _mm256_max_ps(max0, x0);
+            min1 = _mm256_min_ps(min1, x1);
+            max1 = _mm256_max_ps(max1, x1);
+        }
+        if (i + 8 <= size) {
+            const __m256 x = _mm256_loadu_ps(data + i);
+            min0 = _mm256_min_ps(min0, x);
+            max0 = _mm256_max_ps(max0, x);
+            i += 8;
+        }
+        min0 = _mm256_min_ps(min0, min1);
+        max0 = _mm256_max_ps(max0, max1);
+        alignas(32) float mins[8];
+        alignas(32) float maxs[8];
+        _mm256_store_ps(mins, min0);
+        _mm256_store_ps(maxs, max0);
+        std::pair<float, float> result{ *std::min_element(mins, mins + 8), *std::max_element(maxs, maxs + 8) };
+        for (; i < size; ++i) {
+            result.first = std::min(result.first, data[i]);
+            result.second = std::max(result.second, data[i]);
+        }
+        return result;
+    }
+
+    // AVX-512F: регистры по 16 элементов, хвост читается маскированной загрузкой
+
+    __attribute__((target("avx512f"))) inline __mmask16 TailMask(size_t rest)
+    {
+        return static_cast<__mmask16>((1u << rest) - 1);
+    }
+
+    __attribute__((target("avx512f"))) inline size_t IndexOfAvx512(const int32_t* data, size_t size, int32_t value)
+    {
+        const __m512i needle = _mm512_set1_epi32(value);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            const __mmask16 mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i), needle);
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        const __mmask16 tail = TailMask(size - i);
+        const __mmask16 mask = _mm512_mask_cmpeq_epi32_mask(tail, _mm512_maskz_loadu_epi32(tail, data + i), needle);
+        return mask != 0 ? i + __builtin_ctz(mask) : size;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t IndexOfAvx512(const float* data, size_t size, float value)
+    {
+        const __m512 needle = _mm512_set1_ps(value);
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            const __mmask16 mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(data + i), needle, _CMP_EQ_OQ);
+            if (mask != 0) {
+                return i + __builtin_ctz(mask);
+            }
+        }
+        const __mmask16 tail = TailMask(size - i);
+        const __mmask16 mask = _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, data + i), needle, _CMP_EQ_OQ);
+        return mask != 0 ? i + __builtin_ctz(mask) : size;
+    }
+
+    __attribute__((target("avx512f"))) inline size_t CountAvx512(const int32_t* data, size_t size, int32_t value)
+    {
+        const __m512i needle = _mm512_set1_epi32(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            count += __builtin_popcount(_mm512_cmpeq_epi32_mask(_mm512_loadu_si512(data + i), needle));
+        }
+        const __mmask16 tail = TailMask(size - i);
+        return count + __builtin_popcount(_mm512_mask_cmpeq_epi32_mask(tail, _mm512_maskz_loadu_epi32(tail, data + i), needle));
+    }
+
+    __attribute__((target("avx512f"))) inline size_t CountAvx512(const float* data, size_t size, float value)
+    {
+        const __m512 needle = _mm512_set1_ps(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 16 <= size; i += 16) {
+            count += __builtin_popcount(_mm512_cmp_ps_mask(_mm512_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        }
+        const __mmask16 tail = TailMask(size - i);
+        return count + __builtin_popcount(
+            _mm512_mask_cmp_ps_mask(tail, _mm512_maskz_loadu_ps(tail, data + i), needle, _CMP_EQ_OQ));
+    }
+
+    // min/max через сравнение и смешивание: _mm512_min_* и _mm512_reduce_* в GCC 12 дают
+    // ложные предупреждения -Wuninitialized
+    __attribute__((target("avx512f"))) inline void MinMaxStep(__m512i x, __m512i& min, __m512i& max)
+    {
+        min = _mm512_mask_blend_epi32(_mm512_cmplt_epi32_mask(x, min), min, x);
+        max = _mm512_mask_blend_epi32(_mm512_cmpgt_epi32_mask(x, max), max, x);
+    }
+
+    __attribute__((target("avx512f"))) inline void MinMaxStep(__m512 x, __m512& min, __m512& max)
+    {
+        min = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, min, _CMP_LT_OQ), min, x);
+        max = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(x, max, _CMP_GT_OQ), max, x);
+    }
+
+    __attribute__((target("avx512f"))) inline std::pair<int32_t, int32_t> MinMaxAvx512(const int32_t* data, size_t size)
+    {
+        __m512i min0 = _mm512_set1_epi32(data[0]);
+        __m512i max0 = min0;
+        __m512i min1 = min0;
+        __m512i max1 = min0;
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            MinMaxStep(_mm512_loadu_si512(data + i), min0, max0);
+            MinMaxStep(_mm512_loadu_si512(data + i + 16), min1, max1);
+        }
+        for (; i < size; i += 16) {
+            // Элементы за пределами хвоста заменяются первым элементом
+            const __mmask16 tail = TailMask(std::min<size_t>(size - i, 16));
+            MinMaxStep(_mm512_mask_loadu_epi32(_mm512_set1_epi32(data[0]), tail, data + i), min0, max0);
+        }
+        MinMaxStep(min1, min0, max0);
+        MinMaxStep(max1, min0, max0);
+        alignas(64) int32_t mins[16];
+        alignas(64) int32_t maxs[16];
+        _mm512_store_si512(mins, min0);
+        _mm512_store_si512(maxs, max0);
+        return { *std::min_element(mins, mins + 16), *std::max_element(maxs, maxs + 16) };
+    }
+
+    __attribute__((target("avx512f"))) inline std::pair<float, float> MinMaxAvx512(const float* data, size_t size)
+    {
+        __m512 min0 = _mm512_set1_ps(data[0]);
+        __m512 max0 = min0;
+        __m512 min1 = min0;
+        __m512 max1 = min0;
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            MinMaxStep(_mm512_loadu_ps(data + i), min0, max0);
+            MinMaxStep(_mm512_loadu_ps(data + i + 16), min1, max1);
+        }
+        for (; i < size; i += 16) {
+            const __mmask16 tail = TailMask(std::min<size_t>(size - i, 16));
+            MinMaxStep(_mm512_mask_loadu_ps(_mm512_set1_ps(data[0]), tail, data + i), min0, max0);
+        }
+        MinMaxStep(min1, min0, max0);
+        MinMaxStep(max1, min0, max0);
+        alignas(64) float mins[16];
+        alignas(64) float maxs[16];
+        _mm512_store_ps(mins, min0);
+        _mm512_store_ps(maxs, max0);
+        return { *std::min_element(mins, mins + 16), *std::max_element(maxs, maxs + 16) };
+    }
+
+#endif
+
+} // namespace vector_search_detail
+
+// Набор инструкций, которым сейчас выполняется поиск
+inline SimdLevel ActiveSimdLevel() noexcept
+{
+    return vector_search_detail::ActiveLevel().load(std::memory_order_relaxed);
+}
+
+// Ограничивает поиск набором level (для тестов и сравнения ядер). Набор сверх поддерживаемого
+// процессором понижается до DetectSimdLevel(). Возвращает установленный набор
+inline SimdLevel SetSimdLevel(SimdLevel level) noexcept
+{
+    level = std::min(level, DetectSimdLevel());
+    vector_search_detail::ActiveLevel().store(level, std::memory_order_relaxed);
+    return level;
+}
+
+// Линейный поиск по непрерывному массиву. Для int32_t и float используются векторные
+// инструкции лучшего набора, доступного во время выполнения (SSE4.2, AVX2, AVX-512),
+// для остальных типов и других процессоров - алгоритмы std. Сравнение float - как у
+// operator==: NaN не равен ничему, -0.0 равен 0.0. MinMax для float с NaN не определён
+
+inline constexpr size_t kNotFound = size_t(-1);
+
+// Индекс первого элемента, равного value, или kNotFound
+template <typename T>
+size_t IndexOf(const T* data, size_t size, const std::remove_const_t<T>& value)
+{
+    using namespace vector_search_detail;
+    size_t index = size;
+    if constexpr (kHasKernels<T>) {
+        switch (ActiveSimdLevel()) {
+#ifdef VECTOR_SEARCH_X86_KERNELS
+        case SimdLevel::kAvx512:
+            index = IndexOfAvx512(data, size, value);
+            break;
+        case SimdLevel::kAvx2:
+            index = IndexOfAvx2(data, size, value);
+            break;
+        case SimdLevel::kSse42:
+            index = IndexOfSse42(data, size, value);
+            break;
+#endif
+        default:
+            index = IndexOfScalar(data, size, value);
+            break;
+        }
+    }
+    else {
+        index = IndexOfScalar(data, size, value);
+    }
+    return index == size ? kNotFound : index;
+}
+
+// Число элементов, равных value
+template <typename T>
+size_t Count(const T* data, size_t size, const std::remove_const_t<T>& value)
+{
+    using namespace vector_search_detail;
+    if constexpr (kHasKernels<T>) {
+        switch (ActiveSimdLevel()) {
+#ifdef VECTOR_SEARCH_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return CountAvx512(data, size, value);
+        case SimdLevel::kAvx2:
+            return CountAvx2(data, size, value);
+        case SimdLevel::kSse42:
+            return CountSse42(data, size, value);
+#endif
+        default:
+            break;
+        }
+    }
+    return CountScalar(data, size, value);
+}
+
+// Наименьший и наибольший элементы непустого массива
+template <typename T>
+std::pair<T, T> MinMax(const T* data, size_t size)
+{
+    using namespace vector_search_detail;
+    assert(size > 0);
+    if constexpr (kHasKernels<T>) {
+        switch (ActiveSimdLevel()) {
+#ifdef VECTOR_SEARCH_X86_KERNELS
+        case SimdLevel::kAvx512:
+            return MinMaxAvx512(data, size);
+        case SimdLevel::kAvx2:
+            return MinMaxAvx2(data, size);
+        case SimdLevel::kSse42:
+            return MinMaxSse42(data, size);
+#endif
+        default:
+            break;
+        }
+    }
+    return MinMaxScalar(data, size);
+}
+
+// Те же операции над Vector
+
+template <typename T, typename Alloc, typename Growth>
+size_t IndexOf(const Vector<T, Alloc, Growth>& v, const std::remove_const_t<T>& value) {
+    return IndexOf(v.begin(), v.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::const_iterator Find(const Vector<T, Alloc, Growth>& v, const std::remove_const_t<T>& value)
+{
+    const size_t index = IndexOf(v, value);
+    return index == kNotFound ? v.end() : v.begin() + index;
+}
+
+template <typename T, typename Alloc, typename Growth>
+typename Vector<T, Alloc, Growth>::iterator Find(Vector<T, Alloc, Growth>& v, const std::remove_const_t<T>& value)
+{
+    const size_t index = IndexOf(std::as_const(v), value);
+    return index == kNotFound ? v.end() : v.begin() + index;
+}
+
+template <typename T, typename Alloc, typename Growth>
+bool Contains(const Vector<T, Alloc, Growth>& v, const std::remove_const_t<T>& value) {
+    return IndexOf(v, value) != kNotFound;
+}
+
+template <typename T, typename Alloc, typename Growth>
+size_t Count(const Vector<T, Alloc, Growth>& v, const std::remove_const_t<T>& value) {
+    return Count(v.begin(), v.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth>
+std::pair<T, T> MinMax(const Vector<T, Alloc, Growth>& v) {
+    return MinMax(v.begin(), v.Size());
+}
@@ -0,0 +1,123 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <unordered_set>
+
+// Счётчики работы с памятью одного вектора. Собираются, только если программа
+// скомпилирована с макросом VECTOR_ENABLE_STATS
+struct VectorStats {
+    // Число выделений буфера (включая реаллокацию на месте) и их суммарный объём
+    size_t allocations = 0;
+    size_t bytes_allocated = 0;
+    // Число переносов существующих элементов в буфер другой вместимости
+    size_t reallocations = 0;
+    // Элементы, перенесённые при реаллокациях перемещением (или побайтово) и копированием
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    size_t peak_capacity = 0;
+
+    void Merge(const VectorStats& other) noexcept {
+        allocations += other.allocations;
+        bytes_allocated += other.bytes_allocated;
+        reallocations += other.reallocations;
+        elements_moved += other.elements_moved;
+        elements_copied += other.elements_copied;
+        peak_capacity = std::max(peak_capacity, other.peak_capacity);
+    }
+};
+
+class VectorStatsRegistry;
+
+// Статистика вектора, зарегистрированная в глобальном реестре на время жизни вектора
+class RegisteredVectorStats {
+public:
+    RegisteredVectorStats(const char* type_name, size_t element_size);
+
+    RegisteredVectorStats(const RegisteredVectorStats&) = delete;
+    RegisteredVectorStats& operator=(const RegisteredVectorStats&) = delete;
+
+    ~RegisteredVectorStats();
+
+    // Забирает статистику other, например при перемещении вектора
+    void TakeFrom(RegisteredVectorStats& other) noexcept {
+        stats.Merge(other.stats);
+        other.stats = VectorStats{};
+    }
+
+    VectorStats stats;
+    // Имя типа элемента (typeid(T).name()) и его размер
+    const char* type_name;
+    size_t element_size;
+};
+
+// Глобальный реестр живых векторов и суммарная статистика уже уничтоженных.
+// Сами счётчики векторов не атомарны, поэтому обходить реестр следует, когда векторы
+// не изменяются другими потоками
+class VectorStatsRegistry {
+public:
+    static VectorStatsRegistry& Instance() {
+        static VectorStatsRegistry instance;
+        return instance;
+    }
+
+    // Вызывает f(const RegisteredVectorStats&) для каждого живого вектора
+    template <typename F>
+    void ForEach(F f) const {
+        std::lock_guard guard(mutex_);
+        for (const RegisteredVectorStats* stats : live_) {
+            f(*stats);
+        }
+    }
+
+    // Суммарная статистика всех векторов, живых и уничтоженных (кроме живых векторов,
+    // которые не удалось зарегистрировать)
+    VectorStats Totals() const {
+        std::lock_guard guard(mutex_);
+        VectorStats totals = retired_;
+        for (const RegisteredVectorStats* stats : live_) {
+            totals.Merge(stats->stats);
+        }
+        return totals;
+    }
+
+    size_t LiveCount() const {
+        std::lock_guard guard(mutex_);
+        return live_.size();
+    }
+
+private:
+    friend class RegisteredVectorStats;
+
+    // Без памяти под запись вектор не попадёт ни в обход, ни в Totals, пока жив: его
+    // счётчики учтутся в Totals только после уничтожения
+    void Register(const RegisteredVectorStats* stats) noexcept {
+        std::lock_guard guard(mutex_);
+        try {
+            live_.insert(stats);
+        }
+        catch (...) {
+        }
+    }
+
+    void Unregister(const RegisteredVectorStats* stats) noexcept {
+        std::lock_guard guard(mutex_);
+        live_.erase(stats);
+        retired_.Merge(stats->stats);
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_set<const RegisteredVectorStats*> live_;
+    VectorStats retired_;
+};
+
+inline RegisteredVectorStats::RegisteredVectorStats(const char* type_name, size_t element_size)
+    : type_name(type_name)
+    , element_size(element_size)
+{
+    VectorStatsRegistry::Instance().Register(this);
+}
+
+inline RegisteredVectorStats::~RegisteredVectorStats() {
+    VectorStatsRegistry::Instance().Unregister(this);
+}